@@ -39,7 +39,7 @@ win32 {
         INCLUDEPATH += $$[QT_INSTALL_PREFIX]/src/3rdparty/zlib
         #INCLUDEPATH += C:/QtSDK/QtSources/4.7.2/src/3rdparty/zlib
 	DEFINES += _CRT_SECURE_NO_DEPRECATE
-    LIBS += setupapi.lib
+    LIBS += setupapi.lib psapi.lib
 }
 macx {
         MOC_DIR = build/moc
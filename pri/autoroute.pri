@@ -20,6 +20,8 @@
 HEADERS += \
 src/autoroute/autorouter.h \
 src/autoroute/cmrouter/cmrouter.h \
+src/autoroute/cmrouter/drcshape.h \
+src/autoroute/cmrouter/freespaceindex.h \
 src/autoroute/cmrouter/priorityqueue.h \
 src/autoroute/autorouteprogressdialog.h \
 src/autoroute/autoroutersettingsdialog.h \
@@ -30,6 +32,8 @@ src/autoroute/cmrouter/tileutils.h
 SOURCES += \
 src/autoroute/autorouter.cpp \
 src/autoroute/cmrouter/cmrouter.cpp \
+src/autoroute/cmrouter/drcshape.cpp \
+src/autoroute/cmrouter/freespaceindex.cpp \
 src/autoroute/autorouteprogressdialog.cpp \
 src/autoroute/autoroutersettingsdialog.cpp \
 src/autoroute/cmrouter/panelizer.cpp  \
@@ -22,6 +22,7 @@ src/connectors/bus.h \
 src/connectors/busshared.h \
 src/connectors/connector.h \
 src/connectors/connectoritem.h \
+src/connectors/connectoritemlist.h \
 src/connectors/nonconnectoritem.h \
 src/connectors/connectorshared.h \
 src/connectors/ercdata.h \
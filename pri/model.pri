@@ -21,6 +21,7 @@ HEADERS += \
     src/model/modelpart.h \
     src/model/modelpartshared.h \
     src/model/palettemodel.h \
+    src/model/sketchcache.h \
     src/model/sketchmodel.h 
     
 SOURCES += \
@@ -28,4 +29,5 @@ SOURCES += \
     src/model/modelpart.cpp \
     src/model/modelpartshared.cpp \
     src/model/palettemodel.cpp \
+    src/model/sketchcache.cpp \
     src/model/sketchmodel.cpp 
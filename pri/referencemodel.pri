@@ -27,8 +27,10 @@
 HEADERS += \
     src/referencemodel/sqlitereferencemodel.h \
     src/referencemodel/referencemodel.h \
+    src/referencemodel/propertyindex.h \
     src/referencemodel/daos.h 
 
 SOURCES += \
     src/referencemodel/sqlitereferencemodel.cpp \
+    src/referencemodel/propertyindex.cpp \
     src/referencemodel/daos.cpp 
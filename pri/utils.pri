@@ -45,6 +45,7 @@ src/utils/graphutils.h \
 src/utils/ratsnestcolors.h \
 src/utils/svgandpartfilepath.h \
 src/utils/textutils.h \
+src/utils/tracespan.h \
 src/utils/zoomslider.h 
  
 SOURCES += \
@@ -67,6 +68,7 @@ src/utils/graphicsutils.cpp \
 src/utils/graphutils.cpp \
 src/utils/ratsnestcolors.cpp \
 src/utils/textutils.cpp \
+src/utils/tracespan.cpp \
 src/utils/zoomslider.cpp 
 
 
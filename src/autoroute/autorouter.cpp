@@ -38,10 +38,52 @@ $Date: 2012-03-14 11:23:42 -0700 (Wed, 14 Mar 2012) $
 #include <qmath.h>
 #include <QApplication>
 
+static const int EventInterval = 100;			// ms between event loop visits from inside the routing loops
+
+///////////////////////////////////////////////////////////
+
+AutorouteToken::AutorouteToken()
+{
+}
+
+void AutorouteToken::cancel() {
+	m_cancelled.fetchAndStoreOrdered(1);
+}
+
+void AutorouteToken::cancelTrace() {
+	m_cancelTrace.fetchAndStoreOrdered(1);
+}
+
+void AutorouteToken::stopTracing() {
+	m_stopTracing.fetchAndStoreOrdered(1);
+}
+
+void AutorouteToken::clearTrace() {
+	m_cancelTrace.fetchAndStoreOrdered(0);
+}
+
+bool AutorouteToken::cancelled() const {
+	return m_cancelled != 0;
+}
+
+bool AutorouteToken::traceCancelled() const {
+	return m_cancelTrace != 0;
+}
+
+bool AutorouteToken::tracingStopped() const {
+	return m_stopTracing != 0;
+}
+
+bool AutorouteToken::interrupted() const {
+	return cancelled() || traceCancelled() || tracingStopped();
+}
+
+///////////////////////////////////////////////////////////
+
 Autorouter::Autorouter(PCBSketchWidget * sketchWidget)
 {
 	m_sketchWidget = sketchWidget;
-	m_stopTracing = m_cancelTrace = m_cancelled = false;
+	m_eventTime.start();
 }
 
 Autorouter::~Autorouter(void)
@@ -95,14 +137,22 @@ TraceWire * Autorouter::drawOneTrace(QPointF fromPos, QPointF toPos, double widt
 	return traceWire;
 }
 
+void Autorouter::processEvents() {
+	// keep the progress dialog responsive without re-entering the event loop on every edge
+	if (m_eventTime.elapsed() < EventInterval) return;
+
+	ProcessEventBlocker::processEvents();
+	m_eventTime.restart();
+}
+
 void Autorouter::cancel() {
-	m_cancelled = true;
+	m_token.cancel();
 }
 
 void Autorouter::cancelTrace() {
-	m_cancelTrace = true;
+	m_token.cancelTrace();
 }
 
 void Autorouter::stopTracing() {
-	m_stopTracing = true;
+	m_token.stopTracing();
 }
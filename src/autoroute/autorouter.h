@@ -36,11 +36,37 @@ $Date: 2012-03-14 11:23:42 -0700 (Wed, 14 Mar 2012) $
 #include <QLine>
 #include <QProgressDialog>
 #include <QUndoCommand>
+#include <QAtomicInt>
+#include <QTime>
 
 #include "../viewgeometry.h"
 #include "../viewlayer.h"
 #include "../connectors/connectoritem.h"
 
+// Cancellation state shared between the progress dialog (gui thread) and the routing search (worker thread).
+// The flags are only ever raised by the dialog and polled by the router, so an atomic int per flag is enough.
+
+class AutorouteToken
+{
+public:
+	AutorouteToken();
+
+	void cancel();
+	void cancelTrace();
+	void stopTracing();
+	void clearTrace();
+
+	bool cancelled() const;
+	bool traceCancelled() const;
+	bool tracingStopped() const;
+	bool interrupted() const;
+
+protected:
+	QAtomicInt m_cancelled;
+	QAtomicInt m_cancelTrace;
+	QAtomicInt m_stopTracing;
+};
+
 class Autorouter : public QObject
 {
 	Q_OBJECT
@@ -55,6 +81,7 @@ protected:
 	virtual void cleanUpNets();
 	virtual void updateRoutingStatus();
 	virtual class TraceWire * drawOneTrace(QPointF fromPos, QPointF toPos, double width, ViewLayer::ViewLayerSpec);
+	void processEvents();
 
 public slots:
 	virtual void cancel();
@@ -72,9 +99,8 @@ signals:
 protected:
 	class PCBSketchWidget * m_sketchWidget;
 	QList< QList<class ConnectorItem *>* > m_allPartConnectorItems;
-	bool m_cancelled;
-	bool m_cancelTrace;
-	bool m_stopTracing;
+	AutorouteToken m_token;
+	QTime m_eventTime;
 	bool m_bothSidesNow;
 	int m_maximumProgressPart;
 	int m_currentProgressPart;
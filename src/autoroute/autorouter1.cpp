@@ -207,7 +207,7 @@ void Autorouter1::start()
 	m_viewLayerSpec = ViewLayer::Bottom;
 	dijkstraNets(indexer, netCounters, edges);
 
-	if (m_cancelled || m_stopTracing) {
+	if (m_token.cancelled() || m_token.tracingStopped()) {
 		restoreOriginalState(parentCommand);
 		cleanUp();
 		return;
@@ -227,7 +227,7 @@ void Autorouter1::start()
 
 	clearEdges(edges);
 
-	if (m_cancelled) {
+	if (m_token.cancelled()) {
 		delete lineItem;
 		doCancel(parentCommand);
 		return;
@@ -243,7 +243,7 @@ void Autorouter1::start()
 		runEdges(edges, lineItem, jumperItemStructs, netCounters, routingStatus);
 	}
 
-	if (m_cancelled) {
+	if (m_token.cancelled()) {
 		delete lineItem;
 		doCancel(parentCommand);
 		return;
@@ -350,7 +350,7 @@ void Autorouter1::runEdges(QList<Edge *> & edges, QGraphicsLineItem * lineItem,
 		bool routedFlag = false;
 		QList<Wire *> wires;
 		foreach (Subedge * subedge, subedges) {
-			if (m_cancelled || m_stopTracing) break;
+			if (m_token.cancelled() || m_token.tracingStopped()) break;
 			if (routedFlag) break;
 
 			routedFlag = traceSubedge(subedge, wires, partForBounds, boundingPoly, lineItem);
@@ -363,7 +363,7 @@ void Autorouter1::runEdges(QList<Edge *> & edges, QGraphicsLineItem * lineItem,
 		}
 		subedges.clear();
 
-		if (!routedFlag && !m_stopTracing) {
+		if (!routedFlag && !m_token.tracingStopped()) {
 			if (!alreadyJumper(jumperItemStructs, edge->from, edge->to)) {
 				if (m_sketchWidget->usesJumperItem()) {
 					JumperItemStruct * jumperItemStruct = new JumperItemStruct();
@@ -396,13 +396,13 @@ void Autorouter1::runEdges(QList<Edge *> & edges, QGraphicsLineItem * lineItem,
 		}
 		m_sketchWidget->forwardRoutingStatus(routingStatus);
 
-		ProcessEventBlocker::processEvents();
+		processEvents();
 
-		if (m_cancelled) {
+		if (m_token.cancelled()) {
 			return;
 		}
 
-		if (m_stopTracing) {
+		if (m_token.tracingStopped()) {
 			break;
 		}
 	}
@@ -489,7 +489,7 @@ bool Autorouter1::traceSubedge(Subedge* subedge, QList<Wire *> & wires, ItemBase
 		subedge->wire->setLine(newLine);
 		splitWire = drawOneTrace(subedge->point, originalLine.p2() + subedge->wire->pos(), Wire::STANDARD_TRACE_WIDTH + 1, m_viewLayerSpec);
 		from = splitWire->connector0();
-		ProcessEventBlocker::processEvents();
+		processEvents();
 	}
 	
 	if (from != NULL && to != NULL) {
@@ -880,11 +880,11 @@ void Autorouter1::clearTraces(PCBSketchWidget * sketchWidget, bool deleteAll, QU
 	bool backwards = false;
 	m_autobail = 0;
 	bool result = drawTrace(fromPos, toPos, from, to, wires, boundingPoly, 0, toPos, true, shortcut);
-	if (m_cancelled) {
+	if (m_token.cancelled()) {
 		return false;
 	}
 
-	if (m_cancelTrace || m_stopTracing) {
+	if (m_token.traceCancelled() || m_token.tracingStopped()) {
 	}
 	else if (!result) {
 		//DebugDialog::debug("backwards?");
@@ -895,12 +895,12 @@ void Autorouter1::clearTraces(PCBSketchWidget * sketchWidget, bool deleteAll, QU
 			//DebugDialog::debug("backwards.");
 		}
 	}
-	if (m_cancelled) {
+	if (m_token.cancelled()) {
 		return false;
 	}
 
 	// clear the cancel flag if it's been set so the next trace can proceed
-	m_cancelTrace = false;
+	m_token.clearTrace();
 
 	if (result) {
 		if (backwards) {
@@ -998,7 +998,7 @@ bool Autorouter1::findSpaceFor(ConnectorItem * & from, JumperItem * jumperItem,
 
 	for (qreal radius = minRadius; radius <= maxRadius; radius += (minRadius / 2)) {
 		for (int angle = 0; angle < 360; angle += 10) {
-			if (m_cancelled || m_cancelTrace || m_stopTracing) {
+			if (m_token.interrupted()) {
 				if (ellipse) delete ellipse;
 				if (lineItem) delete lineItem;
 				return false;
@@ -1035,7 +1035,7 @@ bool Autorouter1::findSpaceFor(ConnectorItem * & from, JumperItem * jumperItem,
 								 candidate.y() - (jsz.height() / 2), 
 								 jsz.width(), jsz.height());
 			}
-			ProcessEventBlocker::processEvents();
+			processEvents();
 
 			if (hasCollisions(jumperItem, ViewLayer::UnknownLayer, ellipse, NULL)) {
 				continue;
@@ -1051,7 +1051,7 @@ bool Autorouter1::findSpaceFor(ConnectorItem * & from, JumperItem * jumperItem,
 			else {
 				lineItem->setLine(c.x(), c.y(), candidate.x(), candidate.y());
 			}
-			ProcessEventBlocker::processEvents();
+			processEvents();
 			
 			if (!hasCollisions(jumperItem, from->attachedToViewLayerID(), lineItem, from)) {
 				if (ellipse) delete ellipse;
@@ -1084,10 +1084,10 @@ bool Autorouter1::drawTrace(QPointF fromPos, QPointF toPos, ConnectorItem * from
 		return false;
 	}
 
-	ProcessEventBlocker::processEvents();
+	processEvents();
 	//DebugDialog::debug(QString("%5 drawtrace from:%1 %2, to:%3 %4")
 		//.arg(fromPos.x()).arg(fromPos.y()).arg(toPos.x()).arg(toPos.y()).arg(QString(level, ' ')) );
-	if (m_cancelled || m_cancelTrace || m_stopTracing) {
+	if (m_token.interrupted()) {
 		return false;
 	}
 
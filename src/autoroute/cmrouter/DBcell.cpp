@@ -34,6 +34,8 @@ struct searchArg
     Plane * plane;
 	QGraphicsItem * body;
 	Tile::TileType type;
+	Tile::BodyType bodyType;
+	int net;
 };
 
 #define		TOPLEFT			10
@@ -64,7 +66,7 @@ struct searchArg
  */
 
 void
-DBPlaceCell (Plane * plane, TileRect * rect, QGraphicsItem * body, Tile::TileType type)
+DBPlaceCell (Plane * plane, TileRect * rect, QGraphicsItem * body, Tile::TileType type, Tile::BodyType bodyType, int net)
 /* argument to TiSrArea(), placeCellFunc() */
 /* argument to TiSrArea(), placeCellFunc() */
 {
@@ -73,6 +75,8 @@ DBPlaceCell (Plane * plane, TileRect * rect, QGraphicsItem * body, Tile::TileTyp
     arg.plane = plane;
 	arg.body = body;
 	arg.type = type;
+	arg.bodyType = bodyType;
+	arg.net = net;
 
     (void) TiSrArea((Tile *) NULL, plane, rect, placeCellFunc, (UserData) &arg);
 
@@ -132,6 +136,8 @@ placeCellFunc (Tile * tile, UserData data)
     Tile * tp = clipCellTile (tile, arg->plane, arg->rect);
 	TiSetType(tp, arg->type);
 	TiSetBody(tp, arg->body);
+	TiSetBodyType(tp, arg->bodyType);
+	TiSetNet(tp, arg->net);
 
 /* merge tiles back into the the plane */
 /* requires that TiSrArea visit tiles in NW to SE wavefront */
@@ -425,8 +431,8 @@ ctbListMatch (Tile *tp1, Tile *tp2)
  * ----------------------------------------------------------------------------
  */	
 
-Tile* TiInsertTile(Plane * plane, TileRect * rect, QGraphicsItem * body, Tile::TileType type) {
+Tile* TiInsertTile(Plane * plane, TileRect * rect, QGraphicsItem * body, Tile::TileType type, Tile::BodyType bodyType, int net) {
 
-	DBPlaceCell(plane, rect, body, type);
+	DBPlaceCell(plane, rect, body, type, bodyType, net);
 	return TiSrPoint(NULL, plane, rect->xmini, rect->ymini);
 }
@@ -104,6 +104,9 @@ $Date: 2012-04-06 07:06:09 -0700 (Fri, 06 Apr 2012) $
 
 #include "tile.h"
 #include "tileutils.h"
+#include "drcshape.h"
+#include "freespaceindex.h"
+#include "../../utils/tracespan.h"
 
 #include <qmath.h>
 #include <limits>
@@ -112,14 +115,30 @@ $Date: 2012-04-06 07:06:09 -0700 (Fri, 06 Apr 2012) $
 //#include <QElapsedTimer>			// forces a dependency on qt 4.7
 #include <QSettings>
 #include <QCryptographicHash>
+#include <QtConcurrentRun>
+#include <QFutureWatcher>
+#include <QEventLoop>
 
 static const int MaximumProgress = 1000;
+
+// everything the path search touches; it only reads and writes the tile planes and path units, never the scene,
+// so it can run on a worker thread while the gui thread keeps the progress dialog alive
+struct PathSearch {
+	PriorityQueue<PathUnit *> * p1;
+	PriorityQueue<PathUnit *> * p2;
+	QList<PathUnit *> * p1Terminals;
+	QList<PathUnit *> * p2Terminals;
+	QMultiHash<Tile *, PathUnit *> * tilePathUnits;
+	CompletePath * completePath;
+	bool canCrossLayers;
+};
 static int TileStandardWireWidth = 0;
 static int TileHalfStandardWireWidth = 0;
 static double StandardWireWidth = 0;
 static double HalfStandardWireWidth = 0;
 static const double CloseEnough = 0.5;
 static const int GridEntryAlpha = 128;
+static const double LiveDrcFullPassFraction = 0.5;			// a live pass dirtier than this much of the board becomes a full pass
 
 //static qint64 seedNextTime = 0;
 //static qint64 propagateUnitTime = 0;
@@ -138,6 +157,16 @@ bool edgeLessThan(Edge * e1, Edge * e2)
 	return e1->distance <= e2->distance;
 }
 
+bool largerNetFirst(const QList<ConnectorItem *> & net1, const QList<ConnectorItem *> & net2)
+{
+	return net1.count() > net2.count();
+}
+
+bool pathUnitSourceCostLessThan(PathUnit * pu1, PathUnit * pu2)
+{
+	return pu1->sourceCost < pu2->sourceCost;
+}
+
 bool tilePointRectXLessThan(TilePointRect * tpr1, TilePointRect * tpr2)
 {
 	return tpr1->tilePoint.xi <= tpr2->tilePoint.xi;
@@ -203,6 +232,15 @@ static inline int manhattan(TileRect & tr1, TileRect & tr2) {
 
 static inline GridEntry * TiGetGridEntry(Tile * tile) { return dynamic_cast<GridEntry *>(TiGetClient(tile)); }
 
+static Tile::BodyType bodyTypeOf(QGraphicsItem * item) {
+	// ConnectorItem is a NonConnectorItem and Wire is an ItemBase, so check the subclasses first
+	if (item == NULL) return Tile::NOBODY;
+	if (dynamic_cast<ConnectorItem *>(item)) return Tile::CONNECTORBODY;
+	if (dynamic_cast<Wire *>(item)) return Tile::WIREBODY;
+	if (dynamic_cast<NonConnectorItem *>(item)) return Tile::NONCONNECTORBODY;
+	return Tile::PARTBODY;
+}
+
 void extendToBounds(TileRect & from, TileRect & to) {
 	// bail if it already extends to or past the bounds
 	if (from.xmini <= to.xmini) return;
@@ -305,8 +343,8 @@ int findSpaces(Tile * tile, UserData userData) {
 int findSourceAndDestination(Tile * tile, UserData userData) {
 	SourceAndDestinationStruct * sourceAndDestinationStruct = (SourceAndDestinationStruct *) userData;
 
-	ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(TiGetBody(tile));
-	if (connectorItem) {
+	if (TiGetBodyType(tile) == Tile::CONNECTORBODY) {
+		ConnectorItem * connectorItem = static_cast<ConnectorItem *>(TiGetBody(tile));
 		if (sourceAndDestinationStruct->edge->fromConnectorItems.contains(connectorItem)) {
 			TiSetType(tile, Tile::SOURCE);
 			sourceAndDestinationStruct->tiles.append(tile);
@@ -319,8 +357,8 @@ int findSourceAndDestination(Tile * tile, UserData userData) {
 		return 0;
 	}
 
-	Wire * wire = dynamic_cast<Wire *>(TiGetBody(tile));
-	if (wire) {
+	if (TiGetBodyType(tile) == Tile::WIREBODY) {
+		Wire * wire = static_cast<Wire *>(TiGetBody(tile));
 		TileRect tileRect;
 		TiToRect(tile, &tileRect);
 		int minDim = qMin(tileRect.xmaxi - tileRect.xmini, tileRect.ymaxi - tileRect.ymini);
@@ -464,7 +502,12 @@ CMRouter::CMRouter(PCBSketchWidget * sketchWidget) : Autorouter(sketchWidget)
 		
 	m_bothSidesNow = sketchWidget->routeBothSides();
 	m_unionPlane = m_union90Plane = NULL;
+	m_unionGeneration = 0;
 	m_board = NULL;
+	m_tViaWidthNeeded = m_tViaHeightNeeded = 0;
+	m_liveDrc = m_liveClip = false;
+	m_nextNet = 0;
+	m_displayMessageBoxes = true;
 
 	if (sketchWidget->autorouteTypePCB()) {
 		QList<ItemBase *> boards = sketchWidget->findBoard();
@@ -502,12 +545,17 @@ CMRouter::CMRouter(PCBSketchWidget * sketchWidget) : Autorouter(sketchWidget)
 
 CMRouter::~CMRouter()
 {
+	foreach (FreeSpaceIndex * freeSpaceIndex, m_freeSpaceIndexes) {
+		delete freeSpaceIndex;
+	}
 }
 
 void CMRouter::start()
 {	
+	TraceSpan traceSpan("CMRouter::start");
+
 	if (m_sketchWidget->autorouteTypePCB() && m_board == NULL) {
-		QMessageBox::warning(NULL, QObject::tr("Fritzing"), QObject::tr("Cannot autoroute: no board (or multiple boards) found"));
+		displayMessage(QObject::tr("Cannot autoroute: no board (or multiple boards) found"), true);
 		return;
 	}
 
@@ -556,7 +604,7 @@ void CMRouter::start()
 	}
 
 	if (m_allPartConnectorItems.count() == 0) {
-		QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("No connections to route'."));
+		displayMessage(QObject::tr("No connections to route'."), false);
 		cleanUpNets();
 		return;
 	}
@@ -581,7 +629,7 @@ void CMRouter::start()
 
 	initUndo(parentCommand);
 
-	if (m_cancelled || m_stopTracing) {
+	if (m_token.cancelled() || m_token.tracingStopped()) {
 		restoreOriginalState(parentCommand);
 		cleanUpNets();
 		return;
@@ -621,7 +669,7 @@ void CMRouter::start()
 	qSort(edges.begin(), edges.end(), edgeLessThan);	// sort the edges by distance and layer
 
 	if (edges.count() == 0) {
-		QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("Cannot autoroute: maybe all traces are marked 'do not autoroute'."));
+		displayMessage(QObject::tr("Cannot autoroute: maybe all traces are marked 'do not autoroute'."), false);
 		restoreOriginalState(parentCommand);
 		cleanUpNets();
 		return;
@@ -660,7 +708,7 @@ void CMRouter::start()
 			}
 		}
 		//DebugDialog::debug("after run edges");
-		if (m_cancelled || allDone || m_stopTracing) break;
+		if (m_token.cancelled() || allDone || m_token.tracingStopped()) break;
 
 		ProcessEventBlocker::processEvents();
 		reorder(orderings, currentOrdering, bestOrdering, lineItem);
@@ -677,7 +725,7 @@ void CMRouter::start()
 
 	delete lineItem;
 
-	if (m_cancelled) {
+	if (m_token.cancelled()) {
 		clearEdges(edges);
 		drcClean();
 		clearTracesAndJumpers();
@@ -731,7 +779,7 @@ void CMRouter::start()
 		foreach (ConnectorItem * connectorItem, m_offBoardConnectors) {
 			parts.insert(connectorItem->attachedTo()->layerKinChief());
 		}
-        QMessageBox::information(NULL, QObject::tr("Fritzing"), tr("Note: the autorouter did not route %n parts, because they are not located entirely on the board.", "", parts.count()));
+        displayMessage(tr("Note: the autorouter did not route %n parts, because they are not located entirely on the board.", "", parts.count()), false);
 	}
 }
 
@@ -847,6 +895,8 @@ bool CMRouter::reorderEdges(QList<Ordering *> & orderings, Ordering * currentOrd
 
 bool CMRouter::drc(QString & message) 
 {
+	TraceSpan traceSpan("CMRouter::drc");
+
 	// TODO: 
 	//	what about ground plane?
 
@@ -855,12 +905,7 @@ bool CMRouter::drc(QString & message)
 		return false;
 	}
 
-	QHash<ConnectorItem *, int> indexer;
-	m_sketchWidget->collectAllNets(indexer, m_allPartConnectorItems, false, m_bothSidesNow);
-	fixWidths();
-	cleanUpNets();
-	m_keepout = StandardWireWidth / 2;
-
+	initDrc();
 	bool ok = drc(CMRouter::ReportAllOverlaps, CMRouter::AllowEquipotentialOverlaps, false, false);
     if (ok) {
 		message = tr("Your sketch is ready for production: there are no connectors or traces that overlap or are too close together.");
@@ -884,6 +929,262 @@ bool CMRouter::drc(QString & message)
 	return ok;
 }
 
+void CMRouter::initDrc() 
+{
+	QHash<ConnectorItem *, int> indexer;
+	m_sketchWidget->collectAllNets(indexer, m_allPartConnectorItems, false, m_bothSidesNow);
+	fixWidths();
+	cleanUpNets();
+	m_keepout = StandardWireWidth / 2;
+}
+
+bool CMRouter::liveDrcValid() 
+{
+	// the resident planes are only good as long as the board and the layer setup are unchanged
+	if (m_planes.count() == 0) return true;
+	if (m_bothSidesNow != m_sketchWidget->routeBothSides()) return false;
+
+	QList<ItemBase *> boards = m_sketchWidget->findBoard();
+	if (boards.count() != 1) return false;
+	if (boards.at(0) != m_board) return false;
+
+	return m_board->sceneBoundingRect() == m_maxRect;
+}
+
+bool CMRouter::liveDrc() 
+{
+	if (m_board == NULL) return false;
+
+	m_liveDrc = true;
+	if (m_planes.count() == 0) {
+		// first time: tile everything and keep the planes resident for later updates;
+		// live drc never combines planes, so there is no union plane to keep in step
+		clearGridEntries();
+		initDrc();
+		m_liveRects.clear();
+		m_liveChanged.clear();
+		m_liveRewired.clear();
+		m_liveVacated = QRectF();
+		collectLiveRects(m_liveRects);
+		drc(CMRouter::ReportAllOverlaps, CMRouter::AllowEquipotentialOverlaps, false, false);
+		return true;
+	}
+
+	// only the items reported since the last pass are rescanned
+	QRectF dirty = m_liveVacated;
+	m_liveVacated = QRectF();
+	foreach (QPointer<ItemBase> itemBase, m_liveChanged) {
+		if (itemBase == NULL) continue;
+
+		QHash<QGraphicsItem *, QRectF> liveRects;
+		if (itemBase->scene() == m_sketchWidget->scene()) {
+			collectLiveRects(itemBase, liveRects);
+		}
+
+		QList<QGraphicsItem *> keys = itemBase->childItems();
+		keys.append(itemBase);
+		foreach (QGraphicsItem * key, keys) {
+			QRectF oldRect = m_liveRects.value(key);
+			QRectF newRect = liveRects.value(key);
+			if (oldRect == newRect) continue;
+
+			dirty |= oldRect;
+			dirty |= newRect;
+			if (newRect.isNull()) m_liveRects.remove(key);
+			else m_liveRects.insert(key, newRect);
+			m_drcShapes.remove(key);
+		}
+
+		// connectors of newly added items have no net yet
+		foreach (ConnectorItem * connectorItem, itemBase->cachedConnectorItems()) {
+			if (!m_netIndex.contains(connectorItem)) {
+				m_liveRewired.insert(connectorItem, connectorItem);
+			}
+		}
+	}
+	m_liveChanged.clear();
+
+	// renumber only the nets whose connections changed. Tiles already in the planes carry their net, so the
+	// largest piece of each old net keeps its number and only the members whose number changes get retiled;
+	// connecting a small net to the ground net then retiles the small net, not the ground net
+	QList< QList<ConnectorItem *> > nets;
+	QSet<ConnectorItem *> collected;
+	foreach (QPointer<ConnectorItem> connectorItem, m_liveRewired) {
+		if (connectorItem == NULL) continue;
+		if (connectorItem->scene() != m_sketchWidget->scene()) continue;
+		if (collected.contains(connectorItem)) continue;
+
+		QList<ConnectorItem *> equipotential;
+		equipotential.append(connectorItem);
+		ConnectorItem::collectEqualPotential(equipotential, false, ViewGeometry::NoFlag);
+		foreach (ConnectorItem * ci, equipotential) {
+			collected.insert(ci);
+		}
+		nets.append(equipotential);
+	}
+	qSort(nets.begin(), nets.end(), largerNetFirst);
+
+	QSet<int> claimed;
+	foreach (QList<ConnectorItem *> equipotential, nets) {
+		QHash<int, int> votes;
+		foreach (ConnectorItem * ci, equipotential) {
+			if (m_netIndex.contains(ci)) votes[m_netIndex.value(ci)]++;
+		}
+
+		int net = -1;
+		int most = 0;
+		foreach (int candidate, votes.keys()) {
+			if (claimed.contains(candidate)) continue;
+			if (votes.value(candidate) <= most) continue;
+
+			most = votes.value(candidate);
+			net = candidate;
+		}
+		if (net < 0) net = m_nextNet++;
+		claimed.insert(net);
+
+		foreach (ConnectorItem * ci, equipotential) {
+			if (m_netIndex.contains(ci) && m_netIndex.value(ci) == net) continue;
+
+			m_netIndex.insert(ci, net);
+			dirty |= m_liveRects.value(ci);
+			dirty |= m_liveRects.value(ci->attachedTo());
+		}
+	}
+	m_liveRewired.clear();
+
+	if (dirty.isNull()) return true;
+
+	if (dirty.width() * dirty.height() > m_maxRect.width() * m_maxRect.height() * LiveDrcFullPassFraction) {
+		// retiling most of the board piecemeal costs more than starting over
+		drcClean();
+		return liveDrc();
+	}
+
+	// tiles extend a keepout beyond their items
+	dirty.adjust(-m_keepout, -m_keepout, m_keepout, m_keepout);
+	TileRect dirtyTileRect;
+	qrectToTile(dirty, dirtyTileRect);
+	m_liveClipRect.xmini = qMax(dirtyTileRect.xmini, m_tileMaxRect.xmini);
+	m_liveClipRect.ymini = qMax(dirtyTileRect.ymini, m_tileMaxRect.ymini);
+	m_liveClipRect.xmaxi = qMin(dirtyTileRect.xmaxi, m_tileMaxRect.xmaxi);
+	m_liveClipRect.ymaxi = qMin(dirtyTileRect.ymaxi, m_tileMaxRect.ymaxi);
+	if (m_liveClipRect.xmaxi <= m_liveClipRect.xmini) return true;
+	if (m_liveClipRect.ymaxi <= m_liveClipRect.ymini) return true;
+
+	foreach (QGraphicsItem * item, m_sketchWidget->scene()->items(dirty)) {
+		GridEntry * gridEntry = dynamic_cast<GridEntry *>(item);
+		if (gridEntry) delete gridEntry;
+	}
+
+	m_offBoardConnectors.clear();
+
+	// anything whose tiles might reach into the dirty region gets retiled, clipped to the region
+	dirty.adjust(-m_keepout, -m_keepout, m_keepout, m_keepout);
+	QList<QGraphicsItem *> items = m_sketchWidget->scene()->items(dirty);
+	QList<Tile *> alreadyTiled;
+	m_liveClip = true;
+	foreach (ViewLayer::ViewLayerID viewLayerID, m_planeHash.keys()) {
+		Plane * thePlane = m_planeHash.value(viewLayerID);
+		TiInsertTile(thePlane, &m_liveClipRect, NULL, Tile::SPACE);
+		foreach (TileRect tileRect, m_boardTileRects) {
+			insertTile(thePlane, tileRect, alreadyTiled, NULL, Tile::OBSTACLE, CMRouter::IgnoreAllOverlaps);
+		}
+		tileItems(items, thePlane, viewLayerID, alreadyTiled, CMRouter::ReportAllOverlaps, CMRouter::AllowEquipotentialOverlaps, false);
+		alreadyTiled.clear();
+	}
+	m_liveClip = false;
+
+	return true;
+}
+
+void CMRouter::liveItemChanged(ItemBase * itemBase) 
+{
+	// before the first pass everything gets tiled anyway
+	if (m_planes.count() == 0) return;
+
+	m_liveChanged.insert(itemBase, itemBase);
+}
+
+void CMRouter::liveItemLeaving(ItemBase * itemBase) 
+{
+	// the item may be partly destroyed: only its pointers and memoized rects are used
+	if (m_planes.count() == 0) return;
+
+	m_liveChanged.remove(itemBase);
+	forgetLiveItem(itemBase);
+	foreach (QGraphicsItem * item, itemBase->childItems()) {
+		NonConnectorItem * nonConnectorItem = dynamic_cast<NonConnectorItem *>(item);
+		if (nonConnectorItem == NULL) continue;
+
+		forgetLiveItem(nonConnectorItem);
+	}
+
+	foreach (ConnectorItem * connectorItem, itemBase->cachedConnectorItems()) {
+		m_netIndex.remove(connectorItem);
+		m_liveRewired.remove(connectorItem);
+		foreach (ConnectorItem * toConnectorItem, connectorItem->connectedToItems()) {
+			if (toConnectorItem->attachedTo() == itemBase) continue;
+
+			// whatever this item joined together may now be split
+			m_liveRewired.insert(toConnectorItem, toConnectorItem);
+		}
+	}
+}
+
+void CMRouter::forgetLiveItem(QGraphicsItem * item) 
+{
+	QRectF r = m_liveRects.value(item);
+	if (r.isNull()) return;
+
+	m_liveVacated |= r;
+	m_liveRects.remove(item);
+	m_drcShapes.remove(item);
+}
+
+void CMRouter::liveConnectionsChanged(const QList< QPointer<ConnectorItem> > & connectorItems) 
+{
+	if (m_planes.count() == 0) return;
+
+	foreach (QPointer<ConnectorItem> connectorItem, connectorItems) {
+		if (connectorItem == NULL) continue;
+
+		m_liveRewired.insert(connectorItem, connectorItem);
+	}
+}
+
+void CMRouter::collectLiveRects(QHash<QGraphicsItem *, QRectF> & liveRects) 
+{
+	foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
+		ItemBase * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == NULL) continue;
+
+		collectLiveRects(itemBase, liveRects);
+	}
+}
+
+void CMRouter::collectLiveRects(ItemBase * itemBase, QHash<QGraphicsItem *, QRectF> & liveRects) 
+{
+	if (!itemBase->isVisible()) return;
+	if (itemBase->hidden()) return;
+
+	Wire * wire = qobject_cast<Wire *>(itemBase);
+	if (wire != NULL) {
+		// a wire's own connectors are never tiled
+		if (wire->getTrace()) {
+			liveRects.insert(wire, wire->sceneBoundingRect());
+		}
+		return;
+	}
+
+	foreach (QGraphicsItem * item, itemBase->childItems()) {
+		NonConnectorItem * nonConnectorItem = dynamic_cast<NonConnectorItem *>(item);
+		if (nonConnectorItem == NULL) continue;
+
+		liveRects.insert(item, nonConnectorItem->sceneBoundingRect());
+	}
+}
+
 void CMRouter::drcClean() 
 {
 	clearGridEntries();
@@ -891,6 +1192,8 @@ void CMRouter::drcClean()
 	m_planeHash.clear();
 	m_specHash.clear();
 	m_planes.clear();
+	m_netIndex.clear();
+	m_drcShapes.clear();
 	if (m_unionPlane) {
 		clearPlane(m_unionPlane, false);
 		m_unionPlane = NULL;
@@ -899,6 +1202,7 @@ void CMRouter::drcClean()
 		clearPlane(m_union90Plane, true);
 		m_union90Plane = NULL;
 	}
+	m_unionGeneration++;
 }
 
 bool CMRouter::drc(CMRouter::OverlapType overlapType, CMRouter::OverlapType wireOverlapType, bool eliminateThin, bool combinePlanes) 
@@ -908,6 +1212,7 @@ bool CMRouter::drc(CMRouter::OverlapType overlapType, CMRouter::OverlapType wire
 	if (combinePlanes) {
 		m_unionPlane = initPlane(false);
 		m_union90Plane = initPlane(true);
+		m_unionGeneration++;
 		clipParts();
 	}
 	else {
@@ -916,6 +1221,12 @@ bool CMRouter::drc(CMRouter::OverlapType overlapType, CMRouter::OverlapType wire
 
 	m_offBoardConnectors.clear();
 
+	m_drcShapes.clear();
+	m_netIndex.clear();
+	if (overlapType == CMRouter::AllowEquipotentialOverlaps || wireOverlapType == CMRouter::AllowEquipotentialOverlaps) {
+		initNetIndex();
+	}
+
 	bool gotBad = false;
 
 	QList<Tile *> alreadyTiled;
@@ -966,11 +1277,11 @@ bool CMRouter::runEdges(QList<Edge *> & edges, QVector<int> & netCounters, Routi
 	m_splitDNA.clear();
 	bool result = drc(CMRouter::ClipAllOverlaps, CMRouter::ClipAllOverlaps, true, m_sketchWidget->autorouteTypePCB());
 	if (!result) {
-		m_cancelled = true;
+		m_token.cancel();
 		QString message;
 		if (m_error.length() > 0) message = m_error;
 		else message = QObject::tr("Cannot autoroute: parts or traces are overlapping");
-		QMessageBox::warning(NULL, QObject::tr("Fritzing"), message);
+		displayMessage(message, true);
 		return false;
 	}
 
@@ -1061,13 +1372,13 @@ bool CMRouter::runEdges(QList<Edge *> & edges, QVector<int> & netCounters, Routi
 		}
 		m_sketchWidget->forwardRoutingStatus(routingStatus);
 
-		ProcessEventBlocker::processEvents();
+		processEvents();
 
-		if (m_cancelled) {
+		if (m_token.cancelled()) {
 			break;
 		}
 
-		if (m_stopTracing) {
+		if (m_token.tracingStopped()) {
 			break;
 		}
 	}
@@ -1117,93 +1428,8 @@ Plane * CMRouter::tilePlane(ViewLayer::ViewLayerID viewLayerID, ViewLayer::ViewL
 	if (!initBoard(m_board, thePlane, alreadyTiled)) return thePlane;
 
 	if (m_sketchWidget->autorouteTypePCB()) {
-		// deal with "rectangular" elements first
-		foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
-			ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
-			if (connectorItem == NULL) continue;
-
-			if (!connectorItem->attachedTo()->isVisible()) continue;
-			if (connectorItem->attachedTo()->hidden()) continue;
-			if (connectorItem->attachedToItemType() == ModelPart::Wire) continue;
-			if (!m_sketchWidget->sameElectricalLayer2(connectorItem->attachedToViewLayerID(), viewLayerID)) continue;
-			if (m_offBoardConnectors.contains(connectorItem)) continue;
-
-
-			QPolygonF poly = connectorItem->mapToScene(connectorItem->boundingRect());
-			if (!m_maxRect.contains(poly.boundingRect())) {
-				m_offBoardConnectors.insert(connectorItem);
-				continue;
-			}
-
-			addTile(connectorItem, Tile::OBSTACLE, thePlane, alreadyTiled, overlapType);
-			if (alreadyTiled.count() > 0) {
-				m_hasOverlaps = true;
-				if (overlapType != ReportAllOverlaps) return thePlane;
-				else {
-					displayBadTiles(alreadyTiled);
-					alreadyTiled.clear();
-				}
-			}
-		}
-
-		// now insert the wires
-		QList<Wire *> beenThere;
-		foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
-			Wire * wire = dynamic_cast<Wire *>(item);
-			if (wire == NULL) continue;
-			if (!wire->isVisible()) continue;
-			if (wire->hidden()) continue;
-			if (!wire->getTrace()) continue;
-			if (!wire->isTraceType(m_sketchWidget->getTraceFlag())) continue;
-			if (!m_sketchWidget->sameElectricalLayer2(wire->viewLayerID(), viewLayerID)) continue;
-			if (beenThere.contains(wire)) continue;
-
-			tileWire(wire, beenThere, alreadyTiled, m_sketchWidget->autorouteTypePCB() ? Tile::OBSTACLE : Tile::SCHEMATICWIRESPACE, wireOverlapType, eliminateThin);
-			if (alreadyTiled.count() > 0) {
-				m_hasOverlaps = true;
-				if (overlapType != ReportAllOverlaps) return thePlane;
-				else {
-					displayBadTiles(alreadyTiled);
-					alreadyTiled.clear();
-				}
-			}	
-		}
-
-		// now nonconnectors
-		foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
-			ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
-			if (connectorItem != NULL) {
-				continue;
-			}
-
-			NonConnectorItem * nonConnectorItem = dynamic_cast<NonConnectorItem *>(item);
-			if (nonConnectorItem == NULL) continue;
-
-			if (!nonConnectorItem->attachedTo()->isVisible()) continue;
-			if (nonConnectorItem->attachedTo()->hidden()) continue;
-
-			QPolygonF poly = nonConnectorItem->mapToScene(nonConnectorItem->boundingRect());
-			if (!m_maxRect.contains(poly.boundingRect())) {
-				continue;
-			}
-
-			/*
-			DebugDialog::debug(QString("coords nonconnectoritem %1 %2")
-									.arg(nonConnectorItem->attachedToTitle())
-									.arg(nonConnectorItem->attachedToID())
-									);
-			*/
-
-			addTile(nonConnectorItem, Tile::OBSTACLE, thePlane, alreadyTiled, overlapType);
-			if (alreadyTiled.count() > 0) {
-				m_hasOverlaps = true;
-				if (overlapType != ReportAllOverlaps) return thePlane;
-				else {
-					displayBadTiles(alreadyTiled);
-					alreadyTiled.clear();
-				}
-			}
-		}
+		QList<QGraphicsItem *> items = m_sketchWidget->scene()->items();
+		if (!tileItems(items, thePlane, viewLayerID, alreadyTiled, overlapType, wireOverlapType, eliminateThin)) return thePlane;
 	}
 	else {
 		foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
@@ -1250,6 +1476,99 @@ Plane * CMRouter::tilePlane(ViewLayer::ViewLayerID viewLayerID, ViewLayer::ViewL
 	return thePlane;
 }
 
+bool CMRouter::tileItems(QList<QGraphicsItem *> & items, Plane * thePlane, ViewLayer::ViewLayerID viewLayerID, QList<Tile *> & alreadyTiled, CMRouter::OverlapType overlapType, CMRouter::OverlapType wireOverlapType, bool eliminateThin)
+{
+	// deal with "rectangular" elements first
+	foreach (QGraphicsItem * item, items) {
+		ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (connectorItem == NULL) continue;
+
+		if (!connectorItem->attachedTo()->isVisible()) continue;
+		if (connectorItem->attachedTo()->hidden()) continue;
+		if (connectorItem->attachedToItemType() == ModelPart::Wire) continue;
+		if (!m_sketchWidget->sameElectricalLayer2(connectorItem->attachedToViewLayerID(), viewLayerID)) continue;
+		if (m_offBoardConnectors.contains(connectorItem)) continue;
+
+
+		QPolygonF poly = connectorItem->mapToScene(connectorItem->boundingRect());
+		if (!m_maxRect.contains(poly.boundingRect())) {
+			m_offBoardConnectors.insert(connectorItem);
+			continue;
+		}
+
+		addTile(connectorItem, Tile::OBSTACLE, thePlane, alreadyTiled, overlapType);
+		if (alreadyTiled.count() > 0) {
+			m_hasOverlaps = true;
+			if (overlapType != ReportAllOverlaps) return false;
+			else {
+				displayBadTiles(alreadyTiled);
+				alreadyTiled.clear();
+			}
+		}
+	}
+
+	// now insert the wires
+	QList<Wire *> beenThere;
+	foreach (QGraphicsItem * item, items) {
+		Wire * wire = dynamic_cast<Wire *>(item);
+		if (wire == NULL) continue;
+		if (!wire->isVisible()) continue;
+		if (wire->hidden()) continue;
+		if (!wire->getTrace()) continue;
+		if (!wire->isTraceType(m_sketchWidget->getTraceFlag())) continue;
+		if (!m_sketchWidget->sameElectricalLayer2(wire->viewLayerID(), viewLayerID)) continue;
+		if (beenThere.contains(wire)) continue;
+
+		tileWire(wire, beenThere, alreadyTiled, m_sketchWidget->autorouteTypePCB() ? Tile::OBSTACLE : Tile::SCHEMATICWIRESPACE, wireOverlapType, eliminateThin);
+		if (alreadyTiled.count() > 0) {
+			m_hasOverlaps = true;
+			if (overlapType != ReportAllOverlaps) return false;
+			else {
+				displayBadTiles(alreadyTiled);
+				alreadyTiled.clear();
+			}
+		}	
+	}
+
+	// now nonconnectors
+	foreach (QGraphicsItem * item, items) {
+		ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (connectorItem != NULL) {
+			continue;
+		}
+
+		NonConnectorItem * nonConnectorItem = dynamic_cast<NonConnectorItem *>(item);
+		if (nonConnectorItem == NULL) continue;
+
+		if (!nonConnectorItem->attachedTo()->isVisible()) continue;
+		if (nonConnectorItem->attachedTo()->hidden()) continue;
+
+		QPolygonF poly = nonConnectorItem->mapToScene(nonConnectorItem->boundingRect());
+		if (!m_maxRect.contains(poly.boundingRect())) {
+			continue;
+		}
+
+		/*
+		DebugDialog::debug(QString("coords nonconnectoritem %1 %2")
+								.arg(nonConnectorItem->attachedToTitle())
+								.arg(nonConnectorItem->attachedToID())
+								);
+		*/
+
+		addTile(nonConnectorItem, Tile::OBSTACLE, thePlane, alreadyTiled, overlapType);
+		if (alreadyTiled.count() > 0) {
+			m_hasOverlaps = true;
+			if (overlapType != ReportAllOverlaps) return false;
+			else {
+				displayBadTiles(alreadyTiled);
+				alreadyTiled.clear();
+			}
+		}
+	}
+
+	return true;
+}
+
 void CMRouter::eliminateThinTiles(QList<TileRect> & originalTileRects, Plane * thePlane) {
 
 	QList<TileRect> remainingTileRects;
@@ -1304,6 +1623,7 @@ void CMRouter::eliminateThinTiles(QList<TileRect> & originalTileRects, Plane * t
 			if (extendTile) {
 				QList<Tile *> alreadyTiled;
 				insertTile(thePlane, newRect, alreadyTiled, NULL, Tile::SPACE2, CMRouter::IgnoreAllOverlaps);
+				unionPlaneChanged(thePlane);
 				//drawGridItem(newTile);
 				TileRect leftRect = originalTileRect;
 				leftRect.xmaxi = newRect.xmini;
@@ -1463,6 +1783,7 @@ void CMRouter::eliminateThinTiles2(QList<TileRect> & tileRects, Plane * thePlane
 		if (doInsert) {
 			QList<Tile *> alreadyTiled;
 			insertTile(thePlane, newRect, alreadyTiled, NULL, Tile::SPACE2, CMRouter::IgnoreAllOverlaps);
+			unionPlaneChanged(thePlane);
 			//drawGridItem(newTile);
 			TileRect leftRect = originalTileRect;
 			leftRect.xmaxi = newRect.xmini;
@@ -1511,9 +1832,11 @@ bool CMRouter::initBoard(ItemBase * board, Plane * thePlane, QList<Tile *> & alr
 	gpg.setMinRunSize(1, 1);
 	gpg.getBoardRects(svg, board, FSvgRenderer::printerScale(), m_keepout, rects);
 	QRectF bsbr = board->sceneBoundingRect();
+	m_boardTileRects.clear();
 	foreach (QRect r, rects) {
 		TileRect tileRect;
 		realsToTile(tileRect, r.left() + bsbr.topLeft().x(), r.top() + bsbr.topLeft().y(), r.right() + bsbr.topLeft().x(), r.bottom() + 1 + bsbr.topLeft().y());  // note off-by-one weirdness
+		m_boardTileRects.append(tileRect);
 		insertTile(thePlane, tileRect, alreadyTiled, NULL, Tile::OBSTACLE, CMRouter::IgnoreAllOverlaps);
 		//drawGridItem(tile);
 	}
@@ -2487,13 +2810,15 @@ void CMRouter::initUndo(QUndoCommand * parentCommand)
 	QList<Via *> vias;
 	QList<TraceWire *> traceWires;
 	QList<ItemBase *> doNotAutorouteList;
+	BulkConnectionCommand * connectionCommand = new BulkConnectionCommand(m_sketchWidget, BaseCommand::CrossView, parentCommand);
+	connectionCommand->setUpdateConnections(false);
 	if (m_sketchWidget->usesJumperItem()) {
 		foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
 			JumperItem * jumperItem = dynamic_cast<JumperItem *>(item);
 			if (jumperItem == NULL) continue;
 
 			if (jumperItem->getAutoroutable()) {
-				addUndoConnection(false, jumperItem, parentCommand);
+				addUndoConnection(false, jumperItem, connectionCommand);
 				jumperItems.append(jumperItem);
 				continue;
 			}
@@ -2521,7 +2846,7 @@ void CMRouter::initUndo(QUndoCommand * parentCommand)
 			if (via == NULL) continue;
 
 			if (via->getAutoroutable()) {
-				addUndoConnection(false, via, parentCommand);
+				addUndoConnection(false, via, connectionCommand);
 				vias.append(via);
 				continue;
 			}
@@ -2553,7 +2878,7 @@ void CMRouter::initUndo(QUndoCommand * parentCommand)
 		if (!traceWire->getAutoroutable()) continue;
 
 		traceWires.append(traceWire);
-		addUndoConnection(false, traceWire, parentCommand);
+		addUndoConnection(false, traceWire, connectionCommand);
 	}
 
 	foreach (TraceWire * traceWire, traceWires) {
@@ -2583,24 +2908,22 @@ void CMRouter::restoreOriginalState(QUndoCommand * parentCommand) {
 	undoStack.undo();
 }
 
-void CMRouter::addWireToUndo(Wire * wire, QUndoCommand * parentCommand) 
-{
-	new AddItemCommand(m_sketchWidget, BaseCommand::CrossView, ModuleIDNames::WireModuleIDName, wire->viewLayerSpec(), wire->getViewGeometry(), wire->id(), false, -1, parentCommand);
-	new CheckStickyCommand(m_sketchWidget, BaseCommand::SingleView, wire->id(), false, CheckStickyCommand::RemoveOnly, parentCommand);
-	
-	new WireWidthChangeCommand(m_sketchWidget, wire->id(), wire->width(), wire->width(), parentCommand);
-	new WireColorChangeCommand(m_sketchWidget, wire->id(), wire->colorString(), wire->colorString(), wire->opacity(), wire->opacity(), parentCommand);
-
-}
-
 void CMRouter::addToUndo(QMultiHash<TraceWire *, long> & splitDNA, QUndoCommand * parentCommand) 
 {
+	// a full board can produce thousands of trace segments, so wires and connections go into bulk commands
+	// rather than a handful of commands apiece; the few jumpers and vias keep their individual commands
+	BulkConnectionCommand * disconnectCommand = new BulkConnectionCommand(m_sketchWidget, BaseCommand::CrossView, parentCommand);
+	disconnectCommand->setUpdateConnections(false);
 	foreach (TraceWire * traceWire, splitDNA.uniqueKeys()) {
 		// original doNotAutoroute wire has been split so delete it here because it has been replaced
-		addUndoConnection(false, traceWire, parentCommand);
+		addUndoConnection(false, traceWire, disconnectCommand);
+	}
+	foreach (TraceWire * traceWire, splitDNA.uniqueKeys()) {
 		m_sketchWidget->makeDeleteItemCommand(traceWire, BaseCommand::CrossView, parentCommand);
 	}
 
+	BulkAddWireCommand * addWireCommand = new BulkAddWireCommand(m_sketchWidget, BaseCommand::CrossView, parentCommand);
+
 	QList<long> newDNA = splitDNA.values();
 	QList<TraceWire *> wires;
 	QList<JumperItem *> jumperItems;	
@@ -2618,7 +2941,7 @@ void CMRouter::addToUndo(QMultiHash<TraceWire *, long> & splitDNA, QUndoCommand
 				wire->setAutoroutable(false);
 				ra = true;
 			}
-			addWireToUndo(wire, parentCommand);
+			addWireCommand->addWire(wire->id(), wire->viewLayerSpec(), wire->getViewGeometry(), wire->width(), wire->colorString(), wire->opacity());
 			if (ra) {
 				wire->setAutoroutable(true);
 			}
@@ -2659,45 +2982,45 @@ void CMRouter::addToUndo(QMultiHash<TraceWire *, long> & splitDNA, QUndoCommand
 		}
 	}
 
+	BulkConnectionCommand * connectCommand = new BulkConnectionCommand(m_sketchWidget, BaseCommand::CrossView, parentCommand);
+	connectCommand->setUpdateConnections(false);
 	foreach (TraceWire * traceWire, wires) {
 		//traceWire->debugInfo("trace");
-		addUndoConnection(true, traceWire, parentCommand);
+		addUndoConnection(true, traceWire, connectCommand);
 	}
 	foreach (JumperItem * jumperItem, jumperItems) {
-		addUndoConnection(true, jumperItem, parentCommand);
+		addUndoConnection(true, jumperItem, connectCommand);
 	}
 	foreach (Via * via, vias) {
-		addUndoConnection(true, via, parentCommand);
+		addUndoConnection(true, via, connectCommand);
 	}
 }
 
-void CMRouter::addUndoConnection(bool connect, Via * via, QUndoCommand * parentCommand) {
-	addUndoConnection(connect, via->connectorItem(), BaseCommand::CrossView, parentCommand);
-	addUndoConnection(connect, via->connectorItem()->getCrossLayerConnectorItem(), BaseCommand::CrossView, parentCommand);
+void CMRouter::addUndoConnection(bool connect, Via * via, BulkConnectionCommand * connectionCommand) {
+	addUndoConnection(connect, via->connectorItem(), connectionCommand);
+	addUndoConnection(connect, via->connectorItem()->getCrossLayerConnectorItem(), connectionCommand);
 }
 
-void CMRouter::addUndoConnection(bool connect, JumperItem * jumperItem, QUndoCommand * parentCommand) {
-	addUndoConnection(connect, jumperItem->connector0(), BaseCommand::CrossView, parentCommand);
-	addUndoConnection(connect, jumperItem->connector1(), BaseCommand::CrossView, parentCommand);
+void CMRouter::addUndoConnection(bool connect, JumperItem * jumperItem, BulkConnectionCommand * connectionCommand) {
+	addUndoConnection(connect, jumperItem->connector0(), connectionCommand);
+	addUndoConnection(connect, jumperItem->connector1(), connectionCommand);
 }
 
-void CMRouter::addUndoConnection(bool connect, TraceWire * traceWire, QUndoCommand * parentCommand) {
-	addUndoConnection(connect, traceWire->connector0(), BaseCommand::CrossView, parentCommand);
-	addUndoConnection(connect, traceWire->connector1(), BaseCommand::CrossView, parentCommand);
+void CMRouter::addUndoConnection(bool connect, TraceWire * traceWire, BulkConnectionCommand * connectionCommand) {
+	addUndoConnection(connect, traceWire->connector0(), connectionCommand);
+	addUndoConnection(connect, traceWire->connector1(), connectionCommand);
 }
 
-void CMRouter::addUndoConnection(bool connect, ConnectorItem * connectorItem, BaseCommand::CrossViewType crossView, QUndoCommand * parentCommand) 
+void CMRouter::addUndoConnection(bool connect, ConnectorItem * connectorItem, BulkConnectionCommand * connectionCommand) 
 {
 	foreach (ConnectorItem * toConnectorItem, connectorItem->connectedToItems()) {
 		VirtualWire * vw = qobject_cast<VirtualWire *>(toConnectorItem->attachedTo());
 		if (vw != NULL) continue;
 
-		ChangeConnectionCommand * ccc = new ChangeConnectionCommand(m_sketchWidget, crossView, 
-												toConnectorItem->attachedToID(), toConnectorItem->connectorSharedID(),
-												connectorItem->attachedToID(), connectorItem->connectorSharedID(),
-												ViewLayer::specFromID(toConnectorItem->attachedToViewLayerID()),
-												connect, parentCommand);
-		ccc->setUpdateConnections(false);
+		connectionCommand->addConnection(toConnectorItem->attachedToID(), toConnectorItem->connectorSharedID(),
+										 connectorItem->attachedToID(), connectorItem->connectorSharedID(),
+										 ViewLayer::specFromID(toConnectorItem->attachedToViewLayerID()),
+										 connect);
 	}
 }
 
@@ -2769,7 +3092,9 @@ void CMRouter::displayBadTileRect(TileRect & tileRect) {
 	gridEntry->setBrush(QBrush(c));
 	m_sketchWidget->scene()->addItem(gridEntry);
 	gridEntry->show();
-	ProcessEventBlocker::processEvents();
+	if (!m_liveDrc) {
+		processEvents();
+	}
 }
 
 
@@ -2780,14 +3105,28 @@ Tile * CMRouter::insertTile(Plane * thePlane, QRectF & rect, QList<Tile *> & alr
 	return insertTile(thePlane, tileRect, alreadyTiled, item, tileType, overlapType);
 }
 
-Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType tileType, CMRouter::OverlapType overlapType) 
+Tile * CMRouter::insertTile(Plane * thePlane, TileRect & originalTileRect, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType tileType, CMRouter::OverlapType overlapType) 
 {
+	TileRect tileRect = originalTileRect;
+	if (m_liveClip) {
+		// live drc only retiles the dirty region
+		if (!tileRectsIntersect(&tileRect, &m_liveClipRect)) return NULL;
+
+		tileRect.xmini = qMax(tileRect.xmini, m_liveClipRect.xmini);
+		tileRect.ymini = qMax(tileRect.ymini, m_liveClipRect.ymini);
+		tileRect.xmaxi = qMin(tileRect.xmaxi, m_liveClipRect.xmaxi);
+		tileRect.ymaxi = qMin(tileRect.ymaxi, m_liveClipRect.ymaxi);
+	}
+
 	//infoTileRect("insert tile", tileRect);
 	if (tileRect.xmaxi - tileRect.xmini <= 0) {
 		DebugDialog::debug("attempting to insert zero width tile");
 		return NULL;
 	}
 
+	Tile::BodyType bodyType = bodyTypeOf(item);
+	int net = netIndex(item, bodyType);
+
 	bool gotOverlap = false;
 	bool doClip = false;
 	if (overlapType != CMRouter::IgnoreAllOverlaps) {
@@ -2797,15 +3136,15 @@ Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *>
 				case CMRouter::ReportAllOverlaps:
 					{
 						gotOverlap = true;
-						ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
-						if (connectorItem != NULL) {
+						if (bodyType == Tile::CONNECTORBODY) {
+							ConnectorItem * connectorItem = static_cast<ConnectorItem *>(item);
 							bool samePart = true;
 							foreach (Tile * overlappingTile, alreadyTiled) {
-								ConnectorItem * overlappingConnectorItem = dynamic_cast<ConnectorItem *>(TiGetBody(overlappingTile)); 
-								if (overlappingConnectorItem == NULL) {
+								if (TiGetBodyType(overlappingTile) != Tile::CONNECTORBODY) {
 									samePart = false;
 									break;
 								}
+								ConnectorItem * overlappingConnectorItem = static_cast<ConnectorItem *>(TiGetBody(overlappingTile)); 
 								if (overlappingConnectorItem->attachedTo()->layerKinChief() != connectorItem->attachedTo()->layerKinChief()) {
 									samePart = false;
 									break;
@@ -2817,10 +3156,10 @@ Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *>
 					}
 					break;
 				case CMRouter::ClipAllOverlaps:
-					doClip = overlapsOnly(item, alreadyTiled);
+					doClip = overlapsOnly(alreadyTiled);
 					break;
 				case CMRouter::AllowEquipotentialOverlaps:
-					gotOverlap = !allowEquipotentialOverlaps(item, alreadyTiled);
+					gotOverlap = !allowEquipotentialOverlaps(net, alreadyTiled);
 					doClip = alreadyTiled.count() > 0;
 					break;
                 default:
@@ -2831,6 +3170,12 @@ Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *>
 		}
 	}
 
+	if (gotOverlap) {
+		// the tiles are only bounding rects, so check the real shapes before calling it a violation
+		gotOverlap = !exactClearance(item, bodyType, net, alreadyTiled, overlapType);
+		if (!gotOverlap) doClip = true;
+	}
+
 	if (gotOverlap) {
 		m_overlappingTileRect = tileRect;
 		DebugDialog::debug("!!!!!!!!!!!!!!!!!!!!!!! overlaps not allowed !!!!!!!!!!!!!!!!!!!!!!");
@@ -2838,10 +3183,10 @@ Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *>
 	}
 	Tile * newTile = NULL;
 	if (doClip) {
-		clipInsertTile(thePlane, tileRect, alreadyTiled, item, tileType);
+		clipInsertTile(thePlane, tileRect, alreadyTiled, item, tileType, bodyType, net);
 	}
 	else {
-		newTile = TiInsertTile(thePlane, &tileRect, item, tileType);
+		newTile = TiInsertTile(thePlane, &tileRect, item, tileType, bodyType, net);
 		insertUnion(tileRect, item, tileType);
 	}
 
@@ -2849,14 +3194,17 @@ Tile * CMRouter::insertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *>
 	return newTile;
 }
 
-bool CMRouter::overlapsOnly(QGraphicsItem *, QList<Tile *> & alreadyTiled)
+bool CMRouter::overlapsOnly(QList<Tile *> & alreadyTiled)
 {
 	bool doClip = false;
 	for (int i = alreadyTiled.count() - 1;  i >= 0; i--) {
-		Tile * intersectingTile = alreadyTiled.at(i);
-		if (dynamic_cast<Wire *>(TiGetBody(intersectingTile)) != NULL || dynamic_cast<ConnectorItem *>(TiGetBody(intersectingTile)) != NULL) {
-			doClip = true;
-			continue;
+		switch (TiGetBodyType(alreadyTiled.at(i))) {
+			case Tile::WIREBODY:
+			case Tile::CONNECTORBODY:
+				doClip = true;
+				continue;
+			default:
+				break;
 		}
 
 		alreadyTiled.removeAt(i);
@@ -2865,55 +3213,139 @@ bool CMRouter::overlapsOnly(QGraphicsItem *, QList<Tile *> & alreadyTiled)
 	return doClip;
 }
 
-bool CMRouter::allowEquipotentialOverlaps(QGraphicsItem * item, QList<Tile *> & alreadyTiled)
+bool CMRouter::allowEquipotentialOverlaps(int net, QList<Tile *> & alreadyTiled)
 {
-	bool collected = false;
-	QList<ConnectorItem *> equipotential;
-	Wire * w = dynamic_cast<Wire *>(item);
-	if (w) {
-		equipotential.append(w->connector0());
+	// nets were precomputed by initNetIndex(), so an overlap is allowed only if both tile bodies share a net index
+	if (net < 0) return false;
+
+	foreach (Tile * intersectingTile, alreadyTiled) {
+		switch (TiGetBodyType(intersectingTile)) {
+			case Tile::WIREBODY:
+			case Tile::CONNECTORBODY:
+				if (TiGetNet(intersectingTile) != net) {
+					// overlap not allowed
+					//infoTile("intersecting", intersectingTile);
+					return false;
+				}
+				break;
+			default:
+				return false;
+		}
 	}
-	else {
-		ConnectorItem * ci = dynamic_cast<ConnectorItem *>(item);
-		equipotential.append(ci);
+
+	return true;
+}
+
+bool CMRouter::exactClearance(QGraphicsItem * item, Tile::BodyType bodyType, int net, QList<Tile *> & alreadyTiled, CMRouter::OverlapType overlapType)
+{
+	DrcShape shape = drcShape(item, bodyType);
+	if (shape.isEmpty()) return false;
+
+	ItemBase * chief = NULL;
+	if (bodyType == Tile::CONNECTORBODY) {
+		chief = static_cast<ConnectorItem *>(item)->attachedTo()->layerKinChief();
 	}
-		
+
 	foreach (Tile * intersectingTile, alreadyTiled) {
 		QGraphicsItem * bodyItem = TiGetBody(intersectingTile);
-		ConnectorItem * ci = dynamic_cast<ConnectorItem *>(bodyItem);
-		if (ci != NULL) {
-			if (!collected) {
-				ConnectorItem::collectEqualPotential(equipotential, false, ViewGeometry::NoFlag);
-				collected = true;
-			}
-			if (!equipotential.contains(ci)) {
-				// overlap not allowed
-				//infoTile("intersecting", intersectingTile);
+		Tile::BodyType intersectingType = TiGetBodyType(intersectingTile);
+		switch (intersectingType) {
+			case Tile::CONNECTORBODY:
+				if (chief != NULL && overlapType == CMRouter::ReportAllOverlaps) {
+					if (static_cast<ConnectorItem *>(bodyItem)->attachedTo()->layerKinChief() == chief) continue;
+				}
+				// fall through
+			case Tile::WIREBODY:
+				if (overlapType == CMRouter::AllowEquipotentialOverlaps && net >= 0 && TiGetNet(intersectingTile) == net) continue;
+				break;
+			case Tile::NONCONNECTORBODY:
+				break;
+			default:
+				// board outline or something without an outline
 				return false;
-			}
 		}
-		else {
-			Wire * w = dynamic_cast<Wire *>(bodyItem);
-			if (w == NULL) return false;
 
-			if (!collected) {
-				ConnectorItem::collectEqualPotential(equipotential, false, ViewGeometry::NoFlag);
-				collected = true;
-			}
+		DrcShape intersectingShape = drcShape(bodyItem, intersectingType);
+		if (intersectingShape.isEmpty()) return false;
 
-			if (!equipotential.contains(w->connector0())) {
-				// overlap not allowed
-				//infoTile("intersecting", intersectingTile);
-				return false;
-			}
-		}
+		// both tiles were grown by the keepout
+		if (shape.distance(intersectingShape) < m_keepout + m_keepout) return false;
 	}
 
 	return true;
+}
+
+DrcShape CMRouter::drcShape(QGraphicsItem * item, Tile::BodyType bodyType)
+{
+	if (m_drcShapes.contains(item)) return m_drcShapes.value(item);
+
+	DrcShape shape;
+	switch (bodyType) {
+		case Tile::WIREBODY:
+			{
+				Wire * wire = static_cast<Wire *>(item);
+				if (!wire->isCurved()) {
+					shape.setCapsule(wire->mapToScene(wire->line().p1()), wire->mapToScene(wire->line().p2()), wire->width() / 2);
+				}
+			}
+			break;
+		case Tile::CONNECTORBODY:
+		case Tile::NONCONNECTORBODY:
+			{
+				NonConnectorItem * nonConnectorItem = static_cast<NonConnectorItem *>(item);
+				QPainterPath path = nonConnectorItem->mapToScene(nonConnectorItem->shape());
+				if (nonConnectorItem->radius() > 0) {
+					QRectF r = path.boundingRect();
+					shape.setCircle(r.center(), qMin(r.width(), r.height()) / 2);
+				}
+				else {
+					QPolygonF polygon = path.toFillPolygon();
+					if (polygon.count() >= 3) shape.setPolygon(polygon);
+				}
+			}
+			break;
+		default:
+			break;
+	}
 
+	m_drcShapes.insert(item, shape);
+	return shape;
 }
 
-void CMRouter::clipInsertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType type) 
+void CMRouter::initNetIndex()
+{
+	// one collectEqualPotential per net rather than one per overlapping tile
+	m_netIndex.clear();
+	int net = 0;
+	foreach (QGraphicsItem * item, m_sketchWidget->scene()->items()) {
+		ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (connectorItem == NULL) continue;
+		if (m_netIndex.contains(connectorItem)) continue;
+
+		QList<ConnectorItem *> equipotential;
+		equipotential.append(connectorItem);
+		ConnectorItem::collectEqualPotential(equipotential, false, ViewGeometry::NoFlag);
+		foreach (ConnectorItem * ci, equipotential) {
+			m_netIndex.insert(ci, net);
+		}
+		net++;
+	}
+	m_nextNet = net;
+}
+
+int CMRouter::netIndex(QGraphicsItem * item, Tile::BodyType bodyType)
+{
+	switch (bodyType) {
+		case Tile::CONNECTORBODY:
+			return m_netIndex.value(static_cast<ConnectorItem *>(item), -1);
+		case Tile::WIREBODY:
+			return m_netIndex.value(static_cast<Wire *>(item)->connector0(), -1);
+		default:
+			return -1;
+	}
+}
+
+void CMRouter::clipInsertTile(Plane * thePlane, TileRect & tileRect, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType type, Tile::BodyType bodyType, int net) 
 {
 	//infoTileRect("clip insert", tileRect);
 
@@ -2935,7 +3367,7 @@ void CMRouter::clipInsertTile(Plane * thePlane, TileRect & tileRect, QList<Tile
 		if (clipped) continue;
 
 
-		TiInsertTile(thePlane, r, item, type);
+		TiInsertTile(thePlane, r, item, type, bodyType, net);
 		insertUnion(*r, item, type);
 	}
 
@@ -3020,13 +3452,23 @@ PathUnit * CMRouter::initPathUnit(Edge * edge, Tile * tile, PriorityQueue<PathUn
 
 PathUnit * CMRouter::findNearestSpace(PriorityQueue<PathUnit *> & priorityQueue, QMultiHash<Tile *, PathUnit *> & tilePathUnits, int tWidthNeeded, int tHeightNeeded, TileRect & nearestSpace) 
 {
+	QList<PathUnit *> pathUnits;
+	QMultiHash<Tile *, PathUnit *>::const_iterator it = tilePathUnits.constBegin();
+	for (; it != tilePathUnits.constEnd(); ++it) {
+		if (it.value()->priorityQueue != &priorityQueue) continue;
+
+		pathUnits.append(it.value());
+	}
+
+	// closest to the connector first, so the cost bound cuts off the rest of the queue as soon as a space is found
+	qStableSort(pathUnits.begin(), pathUnits.end(), pathUnitSourceCostLessThan);
+
 	PathUnit * nearest = NULL;
 	int bestCost = std::numeric_limits<int>::max();
-	foreach (PathUnit * pathUnit, tilePathUnits.values()) {
-		if (pathUnit->priorityQueue != &priorityQueue) continue;
+	foreach (PathUnit * pathUnit, pathUnits) {
 		if (pathUnit->sourceCost >= bestCost) {
-			// the current nearest PathUnit is closer to the connector than this PathUnit
-			continue;
+			// the current nearest PathUnit is closer to the connector than this PathUnit and all that follow
+			break;
 		}
 
 		findNearestSpaceOne(pathUnit, tWidthNeeded, tHeightNeeded, nearest, bestCost, nearestSpace);
@@ -3070,16 +3512,13 @@ bool CMRouter::findNearestSpaceAux(PathUnit * pathUnit, TileRect & searchRect, i
 	//infoTileRect("search rect", searchRect);
 	bool result = false;
 
-	QList<Tile *> spaces;
-	TiSrArea(NULL, m_unionPlane, &searchRect, findSpaces, &spaces);
-	foreach (Tile * space, spaces) {
-		if (WIDTH(space) < tWidthNeeded || HEIGHT(space) < tHeightNeeded) continue;
-
-		TileRect minCostRect = calcMinCostRect(pathUnit, space);
+	// the index holds only union-plane spaces big enough for the footprint, from both the plain and the rotated plane
+	QVector<TileRect> spaces;
+	freeSpaceIndex(tWidthNeeded, tHeightNeeded)->spaces(searchRect, spaces);
+	foreach (TileRect candidate, spaces) {
+		TileRect minCostRect = calcMinCostRect(pathUnit, candidate);
 		int sourceCost = pathUnit->sourceCost + manhattan(pathUnit->minCostRect, minCostRect);	
 		if (sourceCost < bestCost) {
-			TileRect candidate;
-			TiToRect(space, &candidate);
 			PathUnit::Direction direction = (horizontal) ? (candidate.xmaxi <= LEFT(pathUnit->tile) ? PathUnit::Left : PathUnit::Right)
 														 : (candidate.ymaxi <= YMIN(pathUnit->tile) ? PathUnit::Up : PathUnit::Down);
 			if (appendIfRect(pathUnit, candidate, direction, tWidthNeeded)) {
@@ -3092,31 +3531,6 @@ bool CMRouter::findNearestSpaceAux(PathUnit * pathUnit, TileRect & searchRect, i
 		}
 	}
 
-	TileRect searchRect90;
-	tileRotate90(searchRect, searchRect90);
-	spaces.clear();
-	TiSrArea(NULL, m_union90Plane, &searchRect90, findSpaces, &spaces);
-	foreach (Tile * space, spaces) {
-		if (WIDTH(space) < tWidthNeeded || HEIGHT(space) < tHeightNeeded) continue;
-
-		TileRect spaceTileRect, spaceTileRect90;
-		TiToRect(space, &spaceTileRect90);
-		tileUnrotate90(spaceTileRect90, spaceTileRect);
-		TileRect minCostRect = calcMinCostRect(pathUnit, spaceTileRect);
-		int sourceCost = pathUnit->sourceCost + manhattan(pathUnit->minCostRect, minCostRect);	
-		if (sourceCost < bestCost) {
-			PathUnit::Direction direction = (horizontal) ? (spaceTileRect.xmaxi <= LEFT(pathUnit->tile) ? PathUnit::Left : PathUnit::Right)
-														 : (spaceTileRect.ymaxi <= YMIN(pathUnit->tile) ? PathUnit::Up : PathUnit::Down);
-			if (appendIfRect(pathUnit, spaceTileRect, direction, tWidthNeeded)) {
-				//drawTileRect(spaceTileRect, QColor(255,25,255,128));
-				bestCost = sourceCost;
-				nearestSpace = spaceTileRect;
-				nearest = pathUnit;
-				result = true;
-			}
-		}
-	}
-
 	return result;
 }
 
@@ -3290,15 +3704,75 @@ bool CMRouter::propagate(PriorityQueue<PathUnit *> & p1, PriorityQueue<PathUnit
 	QList<PathUnit *> p1Terminals;
 	QList<PathUnit *> p2Terminals;
 
+
+	completePath.source = completePath.dest = NULL;
+
+	PathSearch pathSearch;
+	pathSearch.p1 = &p1;
+	pathSearch.p2 = &p2;
+	pathSearch.p1Terminals = &p1Terminals;
+	pathSearch.p2Terminals = &p2Terminals;
+	pathSearch.tilePathUnits = &tilePathUnits;
+	pathSearch.completePath = &completePath;
+	pathSearch.canCrossLayers = canCrossLayers;
+
+	// the search reads the via size, which comes from the sketch widget and QSettings; fetch it here, not on the worker
+	getViaSize(m_tViaWidthNeeded, m_tViaHeightNeeded);
+
+	// run the terminal setup and the search off the gui thread, with a local event loop so the progress dialog stays live.
+	// that loop delivers timers and queued signals too, so it counts as processing events: autosave and live drc
+	// check ProcessEventBlocker::isProcessing() and stay off the half-routed sketch until the search hands back its result.
+	// tracePath() stays here because it creates scene items; tiling, drc and undo are still done on the gui thread
+	// by the callers of propagate(), since they read the scene
+	QFutureWatcher<bool> watcher;
+	QEventLoop eventLoop;
+	connect(&watcher, SIGNAL(finished()), &eventLoop, SLOT(quit()));
+	watcher.setFuture(QtConcurrent::run(this, &CMRouter::searchPaths, &pathSearch));
+	if (!watcher.isFinished()) {
+		ProcessEventBlocker::block();
+		eventLoop.exec();
+		ProcessEventBlocker::unblock();
+	}
+	watcher.waitForFinished();
+
+	bool success = watcher.result();
+	if (m_token.interrupted()) {
+		return false;
+	}
+
+	if (success) {
+		tracePath(completePath);
+	}
+
+	foreach (Plane * plane, m_planes) {
+		if (m_sketchWidget->autorouteTypePCB()) {
+			TiSrArea(NULL, plane, &m_tileMaxRect, clearSourceAndDestination, NULL);
+		}
+		else {
+			TiSrArea(NULL, plane, &m_tileMaxRect, clearSourceAndDestination2, NULL);
+		}
+	}
+
+	//hideTiles();
+
+	return success;
+}
+
+bool CMRouter::searchPaths(PathSearch * pathSearch) 
+{
+	PriorityQueue<PathUnit *> & p1 = *pathSearch->p1;
+	PriorityQueue<PathUnit *> & p2 = *pathSearch->p2;
+	CompletePath & completePath = *pathSearch->completePath;
+
 	bool firstTime = true;
 	for (int i = p1.count() - 1; i >= 0; i--) {
 		PathUnit * p1PathUnit = p1.at(i);
-		p1Terminals.append(p1PathUnit);
+		pathSearch->p1Terminals->append(p1PathUnit);
 		p1PathUnit->destCost = std::numeric_limits<int>::max();
 		int keepj = -1;
 		for (int j = p2.count() - 1; j >= 0; j--) {
 			PathUnit * p2PathUnit = p2.at(j);
-			if (firstTime) p2Terminals.append(p2PathUnit);
+			if (firstTime) pathSearch->p2Terminals->append(p2PathUnit);
 			p2PathUnit->destCost = std::numeric_limits<int>::max();
 			int d = manhattan(p1PathUnit->minCostRect, p2PathUnit->minCostRect);
 			if (d < p1PathUnit->destCost) {
@@ -3314,12 +3788,6 @@ bool CMRouter::propagate(PriorityQueue<PathUnit *> & p1, PriorityQueue<PathUnit
 	p1.sort();
 	p2.sort();
 
-
-	//QElapsedTimer propagateUnitTimer;
-
-	//DebugDialog::debug("propagate prelims done");
-
-	completePath.source = completePath.dest = NULL;
 	bool success = false;
 	while (p1.count() > 0 && p2.count() > 0) {
 		PathUnit * pathUnit1 = p1.dequeue();
@@ -3330,47 +3798,23 @@ bool CMRouter::propagate(PriorityQueue<PathUnit *> & p1, PriorityQueue<PathUnit
 			break;
 		}
 
-		//propagateUnitTimer.start();
-		bool ok = propagateUnit(pathUnit1, p1, p2, p2Terminals, tilePathUnits, completePath, canCrossLayers);
-		//propagateUnitTime += propagateUnitTimer.elapsed();
-
-		//DebugDialog::debug("propagate unit done");
-
+		bool ok = propagateUnit(pathUnit1, p1, p2, *pathSearch->p2Terminals, *pathSearch->tilePathUnits, completePath, pathSearch->canCrossLayers);
 		if (ok) {
 			success = true;
 			if (completePath.goodEnough) break;
 		}
 
-		//propagateUnitTimer.start();
-		ok = propagateUnit(pathUnit2, p2, p1, p1Terminals, tilePathUnits, completePath, canCrossLayers);
-		//propagateUnitTime += propagateUnitTimer.elapsed();
+		ok = propagateUnit(pathUnit2, p2, p1, *pathSearch->p1Terminals, *pathSearch->tilePathUnits, completePath, pathSearch->canCrossLayers);
 		if (ok) {
 			success = true;
 			if (completePath.goodEnough) break;
 		}
 
-		ProcessEventBlocker::processEvents();
-		if (m_cancelTrace || m_stopTracing || m_cancelled) {
+		if (m_token.interrupted()) {
 			return false;
 		}
 	}
 
-
-	if (success) {
-		tracePath(completePath);
-	}
-
-	foreach (Plane * plane, m_planes) {
-		if (m_sketchWidget->autorouteTypePCB()) {
-			TiSrArea(NULL, plane, &m_tileMaxRect, clearSourceAndDestination, NULL);
-		}
-		else {
-			TiSrArea(NULL, plane, &m_tileMaxRect, clearSourceAndDestination2, NULL);
-		}
-	}
-
-	//hideTiles();
-
 	return success;
 }
 
@@ -3505,9 +3949,10 @@ void CMRouter::crossLayerSource(PathUnit * pathUnit, PriorityQueue<PathUnit *> &
 
 void CMRouter::crossLayerDest(PathUnit * pathUnit, PriorityQueue<PathUnit *> & sourceQueue, QMultiHash<Tile *, PathUnit *> & tilePathUnits) 
 {
+	// runs on the search thread: uses the via size propagate() fetched
 	PathUnit * nearest = NULL;
-	int tWidthNeeded, tHeightNeeded;
-	getViaSize(tWidthNeeded, tHeightNeeded);
+	int tWidthNeeded = m_tViaWidthNeeded;
+	int tHeightNeeded = m_tViaHeightNeeded;
 	int bestCost = std::numeric_limits<int>::max();
 	TileRect nearestSpace;
 	//drawGridItem(pathUnit->tile);
@@ -4045,6 +4490,40 @@ void CMRouter::insertUnion(TileRect & tileRect, QGraphicsItem *, Tile::TileType
 	TileRect tileRect90;
 	tileRotate90(tileRect, tileRect90);
 	TiInsertTile(m_union90Plane, &tileRect90, NULL, Tile::OBSTACLE);
+
+	// an obstacle only takes space away, so current indexes are clipped rather than rebuilt
+	foreach (FreeSpaceIndex * freeSpaceIndex, m_freeSpaceIndexes) {
+		if (freeSpaceIndex->isStale(m_unionGeneration)) continue;
+
+		freeSpaceIndex->insertObstacle(tileRect);
+	}
+}
+
+void CMRouter::unionPlaneChanged(Plane * plane) {
+	// thin-tile elimination reshapes the space tiles, so the free space indexes have to be rebuilt
+	if (plane == NULL) return;
+	if (plane != m_unionPlane && plane != m_union90Plane) return;
+
+	m_unionGeneration++;
+}
+
+FreeSpaceIndex * CMRouter::freeSpaceIndex(int tWidthNeeded, int tHeightNeeded) {
+	// one index per footprint (in practice the jumper and the via), rebuilt only after the union planes change
+	FreeSpaceIndex * stale = NULL;
+	foreach (FreeSpaceIndex * freeSpaceIndex, m_freeSpaceIndexes) {
+		if (freeSpaceIndex->isCurrent(tWidthNeeded, tHeightNeeded, m_unionGeneration)) return freeSpaceIndex;
+		if (stale == NULL && freeSpaceIndex->isStale(m_unionGeneration)) {
+			stale = freeSpaceIndex;
+		}
+	}
+
+	if (stale == NULL) {
+		stale = new FreeSpaceIndex;
+		m_freeSpaceIndexes.append(stale);
+	}
+
+	stale->build(m_unionPlane, m_tileMaxRect, m_union90Plane, m_tileMaxRect90, tWidthNeeded, tHeightNeeded, m_unionGeneration);
+	return stale;
 }
 
 void CMRouter::clearTracesAndJumpers() {
@@ -4125,6 +4604,23 @@ void CMRouter::saveTracesAndJumpers(Ordering * ordering) {
 
 }
 
+void CMRouter::setDisplayMessageBoxes(bool displayMessageBoxes) 
+{
+	m_displayMessageBoxes = displayMessageBoxes;
+}
+
+void CMRouter::displayMessage(const QString & message, bool warning) 
+{
+	// don't use QMessageBox if running as a service
+	if (!m_displayMessageBoxes) {
+		DebugDialog::debug(message);
+		return;
+	}
+
+	if (warning) QMessageBox::warning(NULL, QObject::tr("Fritzing"), message);
+	else QMessageBox::information(NULL, QObject::tr("Fritzing"), message);
+}
+
 void CMRouter::setMaxCycles(int maxCycles) 
 {
 	m_maxCycles = maxCycles;
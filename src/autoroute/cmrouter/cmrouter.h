@@ -48,6 +48,8 @@ $Date: 2012-01-03 07:53:58 -0800 (Tue, 03 Jan 2012) $
 #include "../autorouter.h"
 #include "priorityqueue.h"
 #include "tile.h"
+#include "drcshape.h"
+#include "freespaceindex.h"
 
 struct Edge {
 	class ConnectorItem * from;
@@ -179,6 +181,11 @@ public:
 	void start();
 	bool drc(QString & message); 
 	void drcClean(); 
+	bool liveDrc(); 
+	bool liveDrcValid(); 
+	void liveItemChanged(ItemBase *);
+	void liveItemLeaving(ItemBase *);
+	void liveConnectionsChanged(const QList< QPointer<ConnectorItem> > &);
 
 public:
 	enum OverlapType {
@@ -196,6 +203,7 @@ public:
 	void setKeepout(double);
 	bool drc(CMRouter::OverlapType, CMRouter::OverlapType wiresOverlap, bool eliminateThin, bool combinePlanes); 
 	Plane * getPlane(ViewLayer::ViewLayerID);
+	void setDisplayMessageBoxes(bool);
 
 public slots:
 	void setMaxCycles(int);
@@ -206,7 +214,7 @@ signals:
 
 protected:
 	void restoreOriginalState(QUndoCommand * parentCommand);
-	void addWireToUndo(Wire * wire, QUndoCommand * parentCommand);
+	void displayMessage(const QString & message, bool warning);
 	void addToUndo(QMultiHash<TraceWire *, long> &, QUndoCommand * parentCommand);
 	void collectEdges(QList<Edge *> & edges);
 	//bool findShortcut(TileRect & tileRect, bool useX, bool targetGreater, JSubedge * subedge, QList<QPointF> & allPoints, int ix);
@@ -230,7 +238,7 @@ protected:
 	void displayBadTileRect(TileRect & tileRect);
 	Tile * addTile(class NonConnectorItem * nci, Tile::TileType type, Plane *, QList<Tile *> & alreadyTiled, CMRouter::OverlapType);
 	Tile * insertTile(Plane* thePlane, TileRect &tileRect, QList<Tile *> &alreadyTiled, QGraphicsItem *, Tile::TileType type, CMRouter::OverlapType);
-	void clipInsertTile(Plane * thePlane, TileRect &, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType type);
+	void clipInsertTile(Plane * thePlane, TileRect &, QList<Tile *> & alreadyTiled, QGraphicsItem * item, Tile::TileType type, Tile::BodyType, int net);
 	void clearGridEntries();
 	void appendIf(PathUnit * pathUnit, Tile * next, QList<Tile *> &, PathUnit::Direction, int tWidthNeeded);
 	bool appendIfRect(PathUnit * pathUnit, TileRect & nextRect, PathUnit::Direction direction, int tWidthNeeded);
@@ -240,6 +248,7 @@ protected:
 	void clearEdge(Edge * edge);
 	PathUnit * initPathUnit(Edge * edge, Tile *, PriorityQueue<PathUnit *> & pq, QMultiHash<Tile *, PathUnit *> &);
 	bool propagate(PriorityQueue<PathUnit *> & p1, PriorityQueue<PathUnit *> & p2, QMultiHash<Tile *, PathUnit *> &, CompletePath  &, bool canCrossLayers);
+	bool searchPaths(struct PathSearch *);
 	bool addJumperItem(PriorityQueue<PathUnit *> & p1, PriorityQueue<PathUnit *> & p2, Edge *, 
 						QMultiHash<Tile *, PathUnit *> &);
 	bool propagateUnit(PathUnit * pathUnit, PriorityQueue<PathUnit *> & sourceQueue, PriorityQueue<PathUnit *> & destQueue, 
@@ -254,11 +263,20 @@ protected:
 	void initConnectorSegments(int ix0, QList<PathUnit *> & fullPath, QList<Segment *> & hSegments, QList<Segment *> & vSegments);
 	bool insideV(const QPointF & check, const QPointF & vertex);
 	void makeAlignTiles(QMultiHash<Tile *, TileRect *> &, Plane * thePlane);
-	bool overlapsOnly(QGraphicsItem * item, QList<Tile *> & alreadyTiled);
+	bool overlapsOnly(QList<Tile *> & alreadyTiled);
 	void eliminateThinTiles(QList<TileRect> & tileRects, Plane * thePlane);
 	void eliminateThinTiles2(QList<TileRect> & tileRects, Plane * thePlane);
 	void clearPlane(Plane * thePlane, bool rotate90);
-	bool allowEquipotentialOverlaps(QGraphicsItem * item, QList<Tile *> & alreadyTiled);
+	bool allowEquipotentialOverlaps(int net, QList<Tile *> & alreadyTiled);
+	void initDrc();
+	void collectLiveRects(QHash<QGraphicsItem *, QRectF> &);
+	void collectLiveRects(ItemBase *, QHash<QGraphicsItem *, QRectF> &);
+	void forgetLiveItem(QGraphicsItem *);
+	bool tileItems(QList<QGraphicsItem *> & items, Plane *, ViewLayer::ViewLayerID, QList<Tile *> & alreadyTiled, CMRouter::OverlapType, CMRouter::OverlapType wireOverlapType, bool eliminateThin);
+	void initNetIndex();
+	bool exactClearance(QGraphicsItem *, Tile::BodyType, int net, QList<Tile *> & alreadyTiled, CMRouter::OverlapType);
+	DrcShape drcShape(QGraphicsItem *, Tile::BodyType);
+	int netIndex(QGraphicsItem *, Tile::BodyType);
 	PathUnit * findNearestSpace(PriorityQueue<PathUnit *> & priorityQueue, QMultiHash<Tile *, PathUnit *> & tilePathUnits, int tWidthNeeded, int tHeightNeeded, TileRect & nearestSpace);
 	bool findNearestSpaceOne(PathUnit * pathUnit, int tWidthNeeded, int tHeightNeeded, PathUnit * & nearest, int & bestCost, TileRect & nearestSpace);
 	bool findNearestSpaceAux(PathUnit * pathUnit, TileRect & searchRect, int tWidthNeeded, int tHeightNeeded, 
@@ -269,14 +287,16 @@ protected:
 	void expand(ConnectorItem * originalConnectorItem, QList<ConnectorItem *> & connectorItems, QSet<Wire *> & traceWires);
 	void clipParts();
 	void insertUnion(TileRect & tileRect, QGraphicsItem *, Tile::TileType tileType);
+	FreeSpaceIndex * freeSpaceIndex(int tWidthNeeded, int tHeightNeeded);
+	void unionPlaneChanged(Plane *);
 	bool blockDirection(PathUnit * pathUnit, PathUnit::Direction direction, TileRect & nextRect, int tWidthNeeded);
 	void clearTracesAndJumpers();
 	void saveTracesAndJumpers(Ordering *);
 	void initUndo(QUndoCommand * parentCommand);
-	void addUndoConnection(bool connect, class JumperItem *, QUndoCommand * parentCommand);
-	void addUndoConnection(bool connect, class Via *, QUndoCommand * parentCommand);
-	void addUndoConnection(bool connect, TraceWire *, QUndoCommand * parentCommand);
-	void addUndoConnection(bool connect, ConnectorItem *, BaseCommand::CrossViewType, QUndoCommand * parentCommand);
+	void addUndoConnection(bool connect, class JumperItem *, BulkConnectionCommand *);
+	void addUndoConnection(bool connect, class Via *, BulkConnectionCommand *);
+	void addUndoConnection(bool connect, TraceWire *, BulkConnectionCommand *);
+	void addUndoConnection(bool connect, ConnectorItem *, BulkConnectionCommand *);
 	bool reorder(QList<Ordering *> & orderings, Ordering *  currentOrdering, Ordering * & bestOrdering, QGraphicsLineItem * lineItem);
 	bool reorderEdges(QList<Ordering *> & orderings, Ordering * currentOrdering, QGraphicsLineItem *);
 	void drawTileRect(TileRect & tileRect, QColor & color);
@@ -312,8 +332,24 @@ protected:
 	int m_maxCycles;
 	QSet<ConnectorItem *> m_offBoardConnectors;
 	QHash<PathUnit *, TileRect> m_nearestSpaces;
+	QList<FreeSpaceIndex *> m_freeSpaceIndexes;
+	int m_unionGeneration;
+	QHash<ConnectorItem *, int> m_netIndex;
+	QHash<QGraphicsItem *, DrcShape> m_drcShapes;
+	int m_nextNet;
+	QHash<QGraphicsItem *, QRectF> m_liveRects;
+	QHash<ItemBase *, QPointer<ItemBase> > m_liveChanged;
+	QHash<ConnectorItem *, QPointer<ConnectorItem> > m_liveRewired;
+	QRectF m_liveVacated;
+	QList<TileRect> m_boardTileRects;
+	TileRect m_liveClipRect;
+	bool m_liveDrc;
+	bool m_liveClip;
 	bool m_hasOverlaps;
+	bool m_displayMessageBoxes;
 	double m_keepout;
+	int m_tViaWidthNeeded;
+	int m_tViaHeightNeeded;
 	QString m_error;
 };
 
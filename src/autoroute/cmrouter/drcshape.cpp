@@ -0,0 +1,147 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+#include "drcshape.h"
+
+#include <qmath.h>
+#include <limits>
+
+static inline double pointToSegment2(double px, double py, double x1, double y1, double x2, double y2)
+{
+	// squared distance from a point to a segment
+	double dx = x2 - x1;
+	double dy = y2 - y1;
+	double len2 = dx * dx + dy * dy;
+	double t = 0;
+	if (len2 > 0) {
+		t = ((px - x1) * dx + (py - y1) * dy) / len2;
+		if (t < 0) t = 0;
+		else if (t > 1) t = 1;
+	}
+	double qx = x1 + t * dx - px;
+	double qy = y1 + t * dy - py;
+	return qx * qx + qy * qy;
+}
+
+static inline double cross(double ax, double ay, double bx, double by, double cx, double cy)
+{
+	return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+static inline bool segmentsCross(double ax1, double ay1, double ax2, double ay2, double bx1, double by1, double bx2, double by2)
+{
+	double d1 = cross(bx1, by1, bx2, by2, ax1, ay1);
+	double d2 = cross(bx1, by1, bx2, by2, ax2, ay2);
+	double d3 = cross(ax1, ay1, ax2, ay2, bx1, by1);
+	double d4 = cross(ax1, ay1, ax2, ay2, bx2, by2);
+	return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+///////////////////////////////////////////////////////////
+
+DrcShape::DrcShape()
+{
+	m_radius = 0;
+}
+
+void DrcShape::setCapsule(const QPointF & p1, const QPointF & p2, double radius)
+{
+	m_x1.append(p1.x());
+	m_y1.append(p1.y());
+	m_x2.append(p2.x());
+	m_y2.append(p2.y());
+	m_radius = radius;
+}
+
+void DrcShape::setCircle(const QPointF & center, double radius)
+{
+	setCapsule(center, center, radius);
+}
+
+void DrcShape::setPolygon(const QPolygonF & polygon)
+{
+	m_polygon = polygon;
+	if (!m_polygon.isClosed()) {
+		m_polygon.append(m_polygon.first());
+	}
+	for (int i = 1; i < m_polygon.count(); i++) {
+		m_x1.append(m_polygon.at(i - 1).x());
+		m_y1.append(m_polygon.at(i - 1).y());
+		m_x2.append(m_polygon.at(i).x());
+		m_y2.append(m_polygon.at(i).y());
+	}
+	m_radius = 0;
+}
+
+bool DrcShape::isEmpty() const
+{
+	return m_x1.isEmpty();
+}
+
+bool DrcShape::containsAnyPoint(const DrcShape & other) const
+{
+	// one outline can sit entirely inside a polygon without any edges coming near each other
+	if (m_polygon.count() < 3) return false;
+
+	for (int i = 0; i < other.m_x1.count(); i++) {
+		if (m_polygon.containsPoint(QPointF(other.m_x1.at(i), other.m_y1.at(i)), Qt::OddEvenFill)) return true;
+	}
+
+	return false;
+}
+
+double DrcShape::distance(const DrcShape & other) const
+{
+	if (isEmpty() || other.isEmpty()) return 0;
+	if (containsAnyPoint(other) || other.containsAnyPoint(*this)) return 0;
+
+	const double * ax1 = m_x1.constData();
+	const double * ay1 = m_y1.constData();
+	const double * ax2 = m_x2.constData();
+	const double * ay2 = m_y2.constData();
+	const double * bx1 = other.m_x1.constData();
+	const double * by1 = other.m_y1.constData();
+	const double * bx2 = other.m_x2.constData();
+	const double * by2 = other.m_y2.constData();
+	int acount = m_x1.count();
+	int bcount = other.m_x1.count();
+
+	double best2 = std::numeric_limits<double>::max();
+	for (int i = 0; i < acount; i++) {
+		for (int j = 0; j < bcount; j++) {
+			if (segmentsCross(ax1[i], ay1[i], ax2[i], ay2[i], bx1[j], by1[j], bx2[j], by2[j])) return 0;
+
+			double d2 = qMin(qMin(pointToSegment2(ax1[i], ay1[i], bx1[j], by1[j], bx2[j], by2[j]),
+								  pointToSegment2(ax2[i], ay2[i], bx1[j], by1[j], bx2[j], by2[j])),
+							 qMin(pointToSegment2(bx1[j], by1[j], ax1[i], ay1[i], ax2[i], ay2[i]),
+								  pointToSegment2(bx2[j], by2[j], ax1[i], ay1[i], ax2[i], ay2[i])));
+			if (d2 < best2) best2 = d2;
+		}
+	}
+
+	double d = qSqrt(best2) - m_radius - other.m_radius;
+	return qMax(0.0, d);
+}
@@ -0,0 +1,62 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+#ifndef DRCSHAPE_H
+#define DRCSHAPE_H
+
+#include <QVector>
+#include <QPointF>
+#include <QPolygonF>
+
+// Exact copper outline used by the drc narrow phase, once the tile plane has found a bounding-rect overlap.
+// Every shape is a set of line segments swept by a radius: a trace is one segment (a capsule),
+// a round pad is a zero-length segment (a circle), and any other pad is its outline with radius 0 plus the polygon itself.
+// Segment endpoints are kept in flat arrays so the distance loops run over contiguous memory.
+
+class DrcShape
+{
+public:
+	DrcShape();
+
+	void setCapsule(const QPointF & p1, const QPointF & p2, double radius);
+	void setCircle(const QPointF & center, double radius);
+	void setPolygon(const QPolygonF &);
+	bool isEmpty() const;
+	double distance(const DrcShape &) const;
+
+protected:
+	bool containsAnyPoint(const DrcShape &) const;
+
+protected:
+	QVector<double> m_x1;
+	QVector<double> m_y1;
+	QVector<double> m_x2;
+	QVector<double> m_y2;
+	double m_radius;
+	QPolygonF m_polygon;
+};
+
+#endif
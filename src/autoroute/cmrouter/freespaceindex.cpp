@@ -0,0 +1,251 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#include "freespaceindex.h"
+#include "tileutils.h"
+
+#include <QtAlgorithms>
+#include <QList>
+
+static const int GridSize = 64;
+
+struct CollectSpacesStruct {
+	QVector<TileRect> * rects;
+	QVector<bool> * rotated;
+	int tWidthNeeded;
+	int tHeightNeeded;
+	bool rotated90;
+};
+
+static int collectFreeSpaces(Tile * tile, UserData userData) {
+	switch (TiGetType(tile)) {
+		case Tile::SPACE:
+		case Tile::SPACE2:
+			break;
+		default:
+			return 0;
+	}
+
+	CollectSpacesStruct * collectSpacesStruct = (CollectSpacesStruct *) userData;
+	// sizes are checked in the tile's own plane, as the placement search always has
+	if (WIDTH(tile) < collectSpacesStruct->tWidthNeeded || HEIGHT(tile) < collectSpacesStruct->tHeightNeeded) return 0;
+
+	TileRect tileRect;
+	TiToRect(tile, &tileRect);
+	if (collectSpacesStruct->rotated90) {
+		TileRect tileRect90 = tileRect;
+		tileUnrotate90(tileRect90, tileRect);
+	}
+	collectSpacesStruct->rects->append(tileRect);
+	collectSpacesStruct->rotated->append(collectSpacesStruct->rotated90);
+	return 0;
+}
+
+static inline bool overlaps(const TileRect & r1, const TileRect & r2) {
+	// same test TiSrArea uses: rects that only share an edge don't overlap; r1 is empty once insertObstacle() has removed it
+	if (r1.xmini >= r1.xmaxi) return false;
+
+	return r1.xmini < r2.xmaxi && r2.xmini < r1.xmaxi && r1.ymini < r2.ymaxi && r2.ymini < r1.ymaxi;
+}
+
+///////////////////////////////////////////////////////////
+
+FreeSpaceIndex::FreeSpaceIndex()
+{
+	m_stamp = 0;
+	m_cellWidth = m_cellHeight = 1;
+	m_columns = m_rows = 0;
+	m_widthNeeded = m_heightNeeded = -1;
+	m_generation = -1;
+}
+
+bool FreeSpaceIndex::isCurrent(int tWidthNeeded, int tHeightNeeded, int generation) const
+{
+	return m_generation == generation && m_widthNeeded == tWidthNeeded && m_heightNeeded == tHeightNeeded;
+}
+
+bool FreeSpaceIndex::isStale(int generation) const
+{
+	return m_generation != generation;
+}
+
+void FreeSpaceIndex::build(Plane * unionPlane, const TileRect & maxRect, Plane * union90Plane, const TileRect & maxRect90, 
+							int tWidthNeeded, int tHeightNeeded, int generation)
+{
+	m_widthNeeded = tWidthNeeded;
+	m_heightNeeded = tHeightNeeded;
+	m_generation = generation;
+	m_maxRect = maxRect;
+	m_rects.clear();
+	m_rotated.clear();
+	m_cells.clear();
+	m_stamps.clear();
+
+	CollectSpacesStruct collectSpacesStruct;
+	collectSpacesStruct.rects = &m_rects;
+	collectSpacesStruct.rotated = &m_rotated;
+	collectSpacesStruct.tWidthNeeded = tWidthNeeded;
+	collectSpacesStruct.tHeightNeeded = tHeightNeeded;
+
+	if (unionPlane) {
+		TileRect searchRect = maxRect;
+		collectSpacesStruct.rotated90 = false;
+		TiSrArea(NULL, unionPlane, &searchRect, collectFreeSpaces, &collectSpacesStruct);
+	}
+	if (union90Plane) {
+		TileRect searchRect90 = maxRect90;
+		collectSpacesStruct.rotated90 = true;
+		TiSrArea(NULL, union90Plane, &searchRect90, collectFreeSpaces, &collectSpacesStruct);
+	}
+
+	m_columns = m_rows = GridSize;
+	m_cellWidth = qMax(1, (maxRect.xmaxi - maxRect.xmini + GridSize - 1) / GridSize);
+	m_cellHeight = qMax(1, (maxRect.ymaxi - maxRect.ymini + GridSize - 1) / GridSize);
+	m_cells.resize(m_columns * m_rows);
+	m_stamps.fill(0, m_rects.count());
+
+	for (int i = 0; i < m_rects.count(); i++) {
+		addToCells(i);
+	}
+}
+
+void FreeSpaceIndex::insertObstacle(const TileRect & obstacle)
+{
+	if (m_rects.isEmpty()) return;
+
+	int c0, r0, c1, r1;
+	cellRange(obstacle, c0, r0, c1, r1);
+
+	m_stamp++;
+	QVector<int> hit;
+	for (int r = r0; r <= r1; r++) {
+		for (int c = c0; c <= c1; c++) {
+			foreach (int i, m_cells.at(r * m_columns + c)) {
+				if (m_stamps.at(i) == m_stamp) continue;
+
+				m_stamps[i] = m_stamp;
+				if (overlaps(m_rects.at(i), obstacle)) {
+					hit.append(i);
+				}
+			}
+		}
+	}
+
+	foreach (int i, hit) {
+		TileRect tileRect = m_rects.at(i);
+		bool rotated = m_rotated.at(i);
+
+		// an emptied rect never overlaps, so the old entry can stay in its cells
+		m_rects[i].xmaxi = m_rects[i].xmini;
+
+		// what is left of the space on each side of the obstacle; every piece is still free, though it may not be a whole tile
+		QList<TileRect> pieces;
+		TileRect piece = tileRect;
+		piece.xmaxi = obstacle.xmini;
+		pieces.append(piece);
+		piece = tileRect;
+		piece.xmini = obstacle.xmaxi;
+		pieces.append(piece);
+		piece = tileRect;
+		piece.xmini = qMax(tileRect.xmini, obstacle.xmini);
+		piece.xmaxi = qMin(tileRect.xmaxi, obstacle.xmaxi);
+		piece.ymaxi = obstacle.ymini;
+		pieces.append(piece);
+		piece.ymaxi = tileRect.ymaxi;
+		piece.ymini = obstacle.ymaxi;
+		pieces.append(piece);
+
+		foreach (TileRect remaining, pieces) {
+			if (!fits(remaining, rotated)) continue;
+
+			m_rects.append(remaining);
+			m_rotated.append(rotated);
+			m_stamps.append(0);
+			addToCells(m_rects.count() - 1);
+		}
+	}
+}
+
+void FreeSpaceIndex::spaces(const TileRect & searchRect, QVector<TileRect> & result)
+{
+	result.clear();
+	if (m_rects.isEmpty()) return;
+
+	int c0, r0, c1, r1;
+	cellRange(searchRect, c0, r0, c1, r1);
+
+	// a rect spanning several cells is listed in each; stamp it so it's only reported once
+	m_stamp++;
+	QVector<int> found;
+	for (int r = r0; r <= r1; r++) {
+		for (int c = c0; c <= c1; c++) {
+			foreach (int i, m_cells.at(r * m_columns + c)) {
+				if (m_stamps.at(i) == m_stamp) continue;
+
+				m_stamps[i] = m_stamp;
+				if (overlaps(m_rects.at(i), searchRect)) {
+					found.append(i);
+				}
+			}
+		}
+	}
+
+	// report in build order (plain plane first), independent of which cell found them
+	qSort(found.begin(), found.end());
+	foreach (int i, found) {
+		result.append(m_rects.at(i));
+	}
+}
+
+void FreeSpaceIndex::addToCells(int index)
+{
+	int c0, r0, c1, r1;
+	cellRange(m_rects.at(index), c0, r0, c1, r1);
+	for (int r = r0; r <= r1; r++) {
+		for (int c = c0; c <= c1; c++) {
+			m_cells[r * m_columns + c].append(index);
+		}
+	}
+}
+
+bool FreeSpaceIndex::fits(const TileRect & tileRect, bool rotated) const
+{
+	// same check as collectFreeSpaces(), made in the plane the rect was found in
+	int width = tileRect.xmaxi - tileRect.xmini;
+	int height = tileRect.ymaxi - tileRect.ymini;
+	if (rotated) qSwap(width, height);
+	return width >= m_widthNeeded && height >= m_heightNeeded;
+}
+
+void FreeSpaceIndex::cellRange(const TileRect & tileRect, int & c0, int & r0, int & c1, int & r1) const
+{
+	// anything beyond the board lands in the border cells, which keeps overlapping rects in a shared cell
+	c0 = qBound(0, (tileRect.xmini - m_maxRect.xmini) / m_cellWidth, m_columns - 1);
+	c1 = qBound(0, (tileRect.xmaxi - 1 - m_maxRect.xmini) / m_cellWidth, m_columns - 1);
+	r0 = qBound(0, (tileRect.ymini - m_maxRect.ymini) / m_cellHeight, m_rows - 1);
+	r1 = qBound(0, (tileRect.ymaxi - 1 - m_maxRect.ymini) / m_cellHeight, m_rows - 1);
+}
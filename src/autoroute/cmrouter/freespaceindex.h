@@ -0,0 +1,75 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef FREESPACEINDEX_H
+#define FREESPACEINDEX_H
+
+#include <QVector>
+
+#include "tile.h"
+
+// Free space on the union planes that is big enough for one jumper or via footprint.
+// Every space tile of at least the needed width and height, from both the plain and the rotated union plane,
+// is stored unrotated and bucketed into a coarse grid over the board, so a placement search only looks at
+// rects that can actually hold the part instead of walking every sliver of space in the plane.
+// The index is rebuilt lazily when CMRouter bumps its generation (new planes or thin-tile elimination);
+// an inserted obstacle only clips the rects it covers.
+
+class FreeSpaceIndex
+{
+public:
+	FreeSpaceIndex();
+
+	bool isCurrent(int tWidthNeeded, int tHeightNeeded, int generation) const;
+	bool isStale(int generation) const;
+	void build(Plane * unionPlane, const TileRect & maxRect, Plane * union90Plane, const TileRect & maxRect90, 
+				int tWidthNeeded, int tHeightNeeded, int generation);
+	void spaces(const TileRect & searchRect, QVector<TileRect> & result);
+	void insertObstacle(const TileRect & obstacle);
+
+protected:
+	void cellRange(const TileRect &, int & c0, int & r0, int & c1, int & r1) const;
+	void addToCells(int index);
+	bool fits(const TileRect &, bool rotated) const;
+
+protected:
+	QVector<TileRect> m_rects;
+	QVector<bool> m_rotated;			// whether each rect came from the rotated plane, where its size was checked
+	QVector< QVector<int> > m_cells;
+	QVector<int> m_stamps;
+	int m_stamp;
+	TileRect m_maxRect;
+	int m_cellWidth;
+	int m_cellHeight;
+	int m_columns;
+	int m_rows;
+	int m_widthNeeded;
+	int m_heightNeeded;
+	int m_generation;
+};
+
+#endif
@@ -670,6 +670,8 @@ TiAlloc()
     TiSetClient(newtile, 0);
     TiSetBody(newtile, 0);
 	TiSetType(newtile, Tile::NOTYPE);
+	TiSetBodyType(newtile, Tile::NOBODY);
+	TiSetNet(newtile, -1);
 
 	//qDebug() << "alloc" << (long) newtile;
 
@@ -744,4 +746,6 @@ dupTileBody (Tile * oldtp, Tile * newtp)
 {
 	TiSetBody(newtp, TiGetBody(oldtp));
 	TiSetType(newtp, TiGetType(oldtp));
+	TiSetBodyType(newtp, TiGetBodyType(oldtp));
+	TiSetNet(newtp, TiGetNet(oldtp));
 }
@@ -83,6 +83,15 @@ struct Tile
 		DUMMYRIGHT,
 		DUMMYBOTTOM
 	};
+
+	// tags the kind of QGraphicsItem stored in ti_body so callers don't need RTTI
+	enum BodyType {
+		NOBODY = 0,
+		PARTBODY,
+		CONNECTORBODY,
+		NONCONNECTORBODY,
+		WIREBODY
+	};
 	
     struct Tile	*ti_lb;		/* Left bottom corner stitch */
     struct Tile	*ti_bl;		/* Bottom left corner stitch */
@@ -90,6 +99,8 @@ struct Tile
     struct Tile	*ti_rt;		/* Right top corner stitch */
     TilePoint	 ti_ll;		/* Lower left coordinate */
 	TileType		 ti_type;		/* another free field */
+	BodyType		 ti_bodyType;	/* kind of item in ti_body */
+	int				 ti_net;		/* equipotential net index of ti_body, or -1 */
     QGraphicsItem *	 ti_body;	/* Body of tile */
     QGraphicsItem *	 ti_client;	/* This space for hire.  */
 };
@@ -223,7 +234,7 @@ void  TiJoinX(Tile *tile1, Tile *tile2, Plane *plane);
 void  TiJoinY(Tile *tile1, Tile *tile2, Plane *plane);
 int   TiSrArea(Tile *hintTile, Plane *plane, TileRect *rect, TileCallback, UserData arg);
 Tile *TiSrPoint( Tile * hintTile, Plane * plane, int x, int y);
-Tile* TiInsertTile(Plane *, TileRect * rect, QGraphicsItem * body, Tile::TileType type);
+Tile* TiInsertTile(Plane *, TileRect * rect, QGraphicsItem * body, Tile::TileType type, Tile::BodyType bodyType = Tile::NOBODY, int net = -1);
 
 #define	TiBottom(tileP)		(YMIN(tileP))
 #define	TiLeft(tileP)		(LEFT(tileP))
@@ -236,6 +247,10 @@ inline void TiSetType(Tile *tileP, Tile::TileType t) { tileP->ti_type = t; }
 inline QGraphicsItem * TiGetBody(Tile * tileP) { return tileP->ti_body; }
 /* See diagnostic subroutine version in tile.c */
 inline void TiSetBody(Tile *tileP, QGraphicsItem *b) { tileP->ti_body = b; }
+inline Tile::BodyType TiGetBodyType(Tile * tileP) { return tileP->ti_bodyType; }
+inline void TiSetBodyType(Tile *tileP, Tile::BodyType t) { tileP->ti_bodyType = t; }
+inline int TiGetNet(Tile * tileP) { return tileP->ti_net; }
+inline void TiSetNet(Tile *tileP, int net) { tileP->ti_net = net; }
 inline QGraphicsItem *	TiGetClient(Tile * tileP) { return tileP->ti_client ; }
 inline void	TiSetClient(Tile *tileP, QGraphicsItem * b)	{ tileP->ti_client = b; }
 
@@ -33,6 +33,9 @@ $Date: 2012-03-05 16:43:16 -0800 (Mon, 05 Mar 2012) $
 #include "connectors/connectoritem.h"
 #include "items/moduleidnames.h"
 #include "utils/bezier.h"
+#include "model/palettemodel.h"
+
+#include <QApplication>
 
 int SelectItemCommand::selectItemCommandID = 3;
 int ChangeNoteTextCommand::changeNoteTextCommandID = 5;
@@ -229,6 +232,89 @@ QString DeleteItemCommand::getParamString() const {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+BulkAddWireCommand::BulkAddWireCommand(SketchWidget * sketchWidget, BaseCommand::CrossViewType crossViewType, QUndoCommand * parent)
+: BaseCommand(crossViewType, sketchWidget, parent)
+{
+	m_firstRedo = true;
+	m_checkStickyCommand = new CheckStickyCommand(sketchWidget, crossViewType, -1, false, CheckStickyCommand::RemoveOnly, NULL);
+}
+
+BulkAddWireCommand::~BulkAddWireCommand() {
+	delete m_checkStickyCommand;
+}
+
+void BulkAddWireCommand::addWire(long id, ViewLayer::ViewLayerSpec viewLayerSpec, const ViewGeometry & viewGeometry, double width, const QString & color, double opacity)
+{
+	int colorIndex = m_colors.indexOf(color);
+	if (colorIndex < 0) {
+		colorIndex = m_colors.count();
+		m_colors.append(color);
+	}
+
+	m_itemIDs.append(id);
+	m_viewLayerSpecs.append(viewLayerSpec);
+	m_zs.append(viewGeometry.z());
+	m_locs.append(viewGeometry.loc());
+	m_lines.append(viewGeometry.line());
+	m_wireFlags.append((int) viewGeometry.wireFlags());
+	m_widths.append(width);
+	m_colorIndexes.append(colorIndex);
+	m_opacities.append(opacity);
+}
+
+int BulkAddWireCommand::wireCount() const {
+	return m_itemIDs.count();
+}
+
+void BulkAddWireCommand::undo()
+{
+	m_checkStickyCommand->undo();
+	for (int i = m_itemIDs.count() - 1; i >= 0; i--) {
+		m_sketchWidget->deleteItem(m_itemIDs.at(i), true, true, false);
+	}
+}
+
+void BulkAddWireCommand::redo()
+{
+	ModelPart * modelPart = m_sketchWidget->paletteModel()->retrieveModelPart(ModuleIDNames::WireModuleIDName);
+	if (modelPart == NULL) return;
+
+	QApplication::setOverrideCursor(Qt::WaitCursor);
+	for (int i = 0; i < m_itemIDs.count(); i++) {
+		ViewGeometry viewGeometry;
+		viewGeometry.setZ(m_zs.at(i));
+		viewGeometry.setLoc(m_locs.at(i));
+		viewGeometry.setLine(m_lines.at(i));
+		viewGeometry.setWireFlags((ViewGeometry::WireFlags) m_wireFlags.at(i));
+		long id = m_itemIDs.at(i);
+		m_sketchWidget->addItem(modelPart, (ViewLayer::ViewLayerSpec) m_viewLayerSpecs.at(i), m_crossViewType, viewGeometry, id, -1, NULL, NULL);
+		m_sketchWidget->changeWireWidth(id, m_widths.at(i));
+		m_sketchWidget->changeWireColor(id, m_colors.at(m_colorIndexes.at(i)), m_opacities.at(i));
+	}
+
+	// the sticky check only looks at the scene the first time through; after that it replays what it recorded
+	if (m_firstRedo) {
+		foreach (long id, m_itemIDs) {
+			m_sketchWidget->checkSticky(id, false, false, m_checkStickyCommand);
+		}
+		m_firstRedo = false;
+	}
+	else {
+		m_checkStickyCommand->redo();
+	}
+	QApplication::restoreOverrideCursor();
+}
+
+QString BulkAddWireCommand::getParamString() const {
+	return QString("BulkAddWireCommand ") 
+		+ BaseCommand::getParamString() + 
+		QString(" wires:%1 colors:%2")
+		.arg(m_itemIDs.count())
+		.arg(m_colors.count());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 MoveItemCommand::MoveItemCommand(SketchWidget* sketchWidget, long itemID, ViewGeometry & oldG, ViewGeometry & newG, bool updateRatsnest, QUndoCommand *parent)
     : BaseCommand(BaseCommand::SingleView, sketchWidget, parent)
 {
@@ -436,6 +522,72 @@ void ChangeConnectionCommand::setUpdateConnections(bool updatem) {
 }
 
 
+BulkConnectionCommand::BulkConnectionCommand(SketchWidget * sketchWidget, BaseCommand::CrossViewType crossView, QUndoCommand * parent)
+: BaseCommand(crossView, sketchWidget, parent)
+{
+	m_updateConnections = true;
+}
+
+void BulkConnectionCommand::addConnection(long fromID, const QString & fromConnectorID,
+										  long toID, const QString & toConnectorID,
+										  ViewLayer::ViewLayerSpec viewLayerSpec, bool connect)
+{
+	m_fromIDs.append(fromID);
+	m_fromConnectorIndexes.append(connectorIndex(fromConnectorID));
+	m_toIDs.append(toID);
+	m_toConnectorIndexes.append(connectorIndex(toConnectorID));
+	m_viewLayerSpecs.append(viewLayerSpec);
+	m_connects.append(connect);
+}
+
+int BulkConnectionCommand::connectorIndex(const QString & connectorID) {
+	int index = m_connectorIDIndexes.value(connectorID, -1);
+	if (index < 0) {
+		index = m_connectorIDs.count();
+		m_connectorIDs.append(connectorID);
+		m_connectorIDIndexes.insert(connectorID, index);
+	}
+
+	return index;
+}
+
+void BulkConnectionCommand::setUpdateConnections(bool updatem) {
+	m_updateConnections = updatem;
+}
+
+int BulkConnectionCommand::connectionCount() const {
+	return m_fromIDs.count();
+}
+
+void BulkConnectionCommand::apply(int row, bool connect) {
+	m_sketchWidget->changeConnection(m_fromIDs.at(row), m_connectorIDs.at(m_fromConnectorIndexes.at(row)), 
+									 m_toIDs.at(row), m_connectorIDs.at(m_toConnectorIndexes.at(row)), 
+									 (ViewLayer::ViewLayerSpec) m_viewLayerSpecs.at(row), 
+									 connect, m_crossViewType == CrossView, m_updateConnections);
+}
+
+void BulkConnectionCommand::undo()
+{
+	for (int i = m_fromIDs.count() - 1; i >= 0; i--) {
+		apply(i, !m_connects.at(i));
+	}
+}
+
+void BulkConnectionCommand::redo()
+{
+	for (int i = 0; i < m_fromIDs.count(); i++) {
+		apply(i, m_connects.at(i));
+	}
+}
+
+QString BulkConnectionCommand::getParamString() const {
+	return QString("BulkConnectionCommand ") 
+		+ BaseCommand::getParamString() + 
+		QString(" connections:%1 connectorids:%2")
+		.arg(m_fromIDs.count())
+		.arg(m_connectorIDs.count());
+}
+
 QString ChangeConnectionCommand::getParamString() const {
 	return QString("ChangeConnectionCommand ") 
 		+ BaseCommand::getParamString() + 
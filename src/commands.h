@@ -29,6 +29,8 @@ $Date: 2012-03-05 16:43:16 -0800 (Mon, 05 Mar 2012) $
 
 #include <QUndoCommand>
 #include <QHash>
+#include <QVector>
+#include <QStringList>
 #include <QPainterPath>
 
 #include "viewgeometry.h"
@@ -143,6 +145,40 @@ protected:
 
 /////////////////////////////////////////////
 
+// Adds many wires in one undo step.  Instead of an AddItemCommand, CheckStickyCommand,
+// WireWidthChangeCommand and WireColorChangeCommand per wire, the geometry and style of
+// every wire is kept in parallel arrays and the colors are shared through a string table.
+
+class BulkAddWireCommand : public BaseCommand
+{
+public:
+	BulkAddWireCommand(class SketchWidget * sketchWidget, BaseCommand::CrossViewType, QUndoCommand * parent);
+	~BulkAddWireCommand();
+	void undo();
+	void redo();
+	void addWire(long id, ViewLayer::ViewLayerSpec, const ViewGeometry &, double width, const QString & color, double opacity);
+	int wireCount() const;
+
+protected:
+	QString getParamString() const;
+
+protected:
+	QVector<long> m_itemIDs;
+	QVector<qint8> m_viewLayerSpecs;
+	QVector<double> m_zs;
+	QVector<QPointF> m_locs;
+	QVector<QLineF> m_lines;
+	QVector<int> m_wireFlags;
+	QVector<double> m_widths;
+	QVector<int> m_colorIndexes;
+	QVector<double> m_opacities;
+	QStringList m_colors;
+	bool m_firstRedo;
+	class CheckStickyCommand * m_checkStickyCommand;
+};
+
+/////////////////////////////////////////////
+
 class MoveItemCommand : public BaseCommand
 {
 public:
@@ -288,6 +324,41 @@ protected:
 
 /////////////////////////////////////////////
 
+// One undo step for any number of connection changes.  Each change is a row across flat arrays;
+// connector ids ("connector0", "connector1", ...) repeat constantly, so they are stored once in a string table.
+// Redo applies the rows in order, undo applies them in reverse with the connect flag flipped.
+
+class BulkConnectionCommand : public BaseCommand
+{
+public:
+	BulkConnectionCommand(class SketchWidget * sketchWidget, BaseCommand::CrossViewType, QUndoCommand * parent);
+	void undo();
+	void redo();
+	void addConnection(long fromID, const QString & fromConnectorID,
+						long toID, const QString & toConnectorID,
+						ViewLayer::ViewLayerSpec, bool connect);
+	void setUpdateConnections(bool updatem);
+	int connectionCount() const;
+
+protected:
+	QString getParamString() const;
+	int connectorIndex(const QString & connectorID);
+	void apply(int row, bool connect);
+
+protected:
+	QVector<long> m_fromIDs;
+	QVector<long> m_toIDs;
+	QVector<int> m_fromConnectorIndexes;
+	QVector<int> m_toConnectorIndexes;
+	QVector<qint8> m_viewLayerSpecs;
+	QVector<bool> m_connects;
+	QStringList m_connectorIDs;
+	QHash<QString, int> m_connectorIDIndexes;
+	bool m_updateConnections;
+};
+
+/////////////////////////////////////////////
+
 class ChangeWireCommand : public BaseCommand
 {
 public:
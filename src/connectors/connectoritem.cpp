@@ -219,6 +219,7 @@ parts editor support
 
 #include "../sketch/infographicsview.h"
 #include "../debugdialog.h"
+#include "../fgraphicsscene.h"
 #include "bus.h"
 #include "../items/wire.h"
 #include "../items/virtualwire.h"
@@ -956,7 +957,7 @@ bool ConnectorItem::connectedTo(ConnectorItem * connectorItem) {
 	return this->m_connectedTo.contains(connectorItem);
 }
 
-const QList< QPointer<ConnectorItem> > & ConnectorItem::connectedToItems() {
+const ConnectorItemList & ConnectorItem::connectedToItems() {
 	return m_connectedTo;
 }
 
@@ -1309,7 +1310,9 @@ void ConnectorItem::collectEqualPotential(QList<ConnectorItem *> & connectorItem
 
 	//DebugDialog::debug("__________________");
 
+	// tempItems keeps the visiting order; the set mirrors it so membership tests stay constant time on big nets
 	QList<ConnectorItem *> tempItems = connectorItems;
+	QSet<ConnectorItem *> tempSet = tempItems.toSet();
 	connectorItems.clear();
 
 	for (int i = 0; i < tempItems.count(); i++) {
@@ -1327,8 +1330,9 @@ void ConnectorItem::collectEqualPotential(QList<ConnectorItem *> & connectorItem
 			if (crossLayers) {
 				ConnectorItem * crossConnectorItem = connectorItem->getCrossLayerConnectorItem();
 				if (crossConnectorItem != NULL) {
-					if (!tempItems.contains(crossConnectorItem)) {
+					if (!tempSet.contains(crossConnectorItem)) {
 						tempItems.append(crossConnectorItem);
+						tempSet.insert(crossConnectorItem);
 					}
 				}
 			}
@@ -1338,7 +1342,7 @@ void ConnectorItem::collectEqualPotential(QList<ConnectorItem *> & connectorItem
 		connectorItems.append(connectorItem);
 
 		foreach (ConnectorItem * cto, connectorItem->connectedToItems()) {
-			if (tempItems.contains(cto)) continue;
+			if (tempSet.contains(cto)) continue;
 
 			if ((skipFlags & ViewGeometry::NormalFlag) && (fromWire == NULL) && (cto->attachedToItemType() != ModelPart::Wire)) {
 				// direct (part-to-part) connections not allowed
@@ -1346,6 +1350,7 @@ void ConnectorItem::collectEqualPotential(QList<ConnectorItem *> & connectorItem
 			}
 
 			tempItems.append(cto);
+			tempSet.insert(cto);
 		}
 
 		Bus * bus = connectorItem->bus();
@@ -1360,8 +1365,9 @@ void ConnectorItem::collectEqualPotential(QList<ConnectorItem *> & connectorItem
 			}
 #endif
 			foreach (ConnectorItem * busConnectedItem, busConnectedItems) {
-				if (!tempItems.contains(busConnectedItem)) {
+				if (!tempSet.contains(busConnectedItem)) {
 					tempItems.append(busConnectedItem);
+					tempSet.insert(busConnectedItem);
 				}
 			}
 		}
@@ -1610,6 +1616,7 @@ void ConnectorItem::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
 {
 	if (m_hybrid) return;
 	if (doNotPaint()) return;
+	if (FGraphicsScene::skipLowDetail(this, painter)) return;
 
 	if (m_legPolygon.count() > 1) {
 		paintLeg(painter);
@@ -1771,7 +1778,7 @@ bool ConnectorItem::connectedToWires() {
 	return false;
 }
 
-void ConnectorItem::displayRatsnest(QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags myFlag) {
+void ConnectorItem::displayRatsnest(QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags myFlag, const ConnectorPairHash * ratsnestGraph) {
 	bool formerColorWasNamed = false;
 	bool gotFormerColor = false;
 	QColor formerColor;
@@ -1811,10 +1818,14 @@ void ConnectorItem::displayRatsnest(QList<ConnectorItem *> & partConnectorItems,
 	}
 
 	ConnectorPairHash result;
-	GraphUtils::chooseRatsnestGraph(&partConnectorItems, (ViewGeometry::RatsnestFlag | ViewGeometry::NormalFlag | ViewGeometry::PCBTraceFlag | ViewGeometry::SchematicTraceFlag) ^ myFlag, result);
+	if (ratsnestGraph == NULL) {
+		// the caller may already have chosen the graph off the gui thread
+		GraphUtils::chooseRatsnestGraph(&partConnectorItems, ratsnestSkipFlags(myFlag), result);
+		ratsnestGraph = &result;
+	}
 
-	foreach (ConnectorItem * key, result.uniqueKeys()) {
-		foreach (ConnectorItem * value, result.values(key)) {
+	foreach (ConnectorItem * key, ratsnestGraph->uniqueKeys()) {
+		foreach (ConnectorItem * value, ratsnestGraph->values(key)) {
 			VirtualWire * vw = infoGraphicsView->makeOneRatsnestWire(key, value, false, color);
 			if (vw) {
 				vw->setColorWasNamed(colorWasNamed);
@@ -1823,6 +1834,10 @@ void ConnectorItem::displayRatsnest(QList<ConnectorItem *> & partConnectorItems,
 	}
 }
 
+ViewGeometry::WireFlags ConnectorItem::ratsnestSkipFlags(ViewGeometry::WireFlags myFlag) {
+	return (ViewGeometry::RatsnestFlag | ViewGeometry::NormalFlag | ViewGeometry::PCBTraceFlag | ViewGeometry::SchematicTraceFlag) ^ myFlag;
+}
+
 void ConnectorItem::clearRatsnestDisplay(QList<ConnectorItem *> & connectorItems) {
 
 	QSet<VirtualWire *> ratsnests;
@@ -1936,7 +1951,7 @@ ConnectorItem * ConnectorItem::findConnectorUnder(bool useTerminalPoint, bool al
 		ConnectorItem * connectorItemUnder = dynamic_cast<ConnectorItem *>(item);
 		if (connectorItemUnder == NULL) continue;
 		if (connectorItemUnder->connector() == NULL) continue;			// shouldn't happen
-		if (attachedTo()->childItems().contains(connectorItemUnder)) continue;		// don't use own connectors
+		if (connectorItemUnder->parentItem() == attachedTo()) continue;		// don't use own connectors
 		if (!this->connectionIsAllowed(connectorItemUnder)) {
 			continue;
 		}
@@ -29,6 +29,7 @@ $Date: 2012-03-31 15:22:41 -0700 (Sat, 31 Mar 2012) $
 
 #include "nonconnectoritem.h"
 #include "connector.h"
+#include "connectoritemlist.h"
 #include "../utils/cursormaster.h"
 
 #include <QThread>
@@ -73,7 +74,7 @@ public:
 	QPointF adjustedTerminalPoint();
 	QPointF sceneAdjustedTerminalPoint(ConnectorItem * anchor);
 	bool connectedTo(ConnectorItem *);
-	const QList< QPointer<ConnectorItem> > & connectedToItems();
+	const ConnectorItemList & connectedToItems();
 	void setHidden(bool hidden);
 	void setInactive(bool inactivate);
 	ConnectorItem * overConnectorItem();
@@ -109,7 +110,7 @@ public:
 	bool isCrossLayerFrom(ConnectorItem * candidate);
 	bool isInLayers(ViewLayer::ViewLayerSpec);
 	ConnectorItem * getCrossLayerConnectorItem();
-	void displayRatsnest(QList<ConnectorItem *> & partsConnectorItems, ViewGeometry::WireFlags myFlag);
+	void displayRatsnest(QList<ConnectorItem *> & partsConnectorItems, ViewGeometry::WireFlags myFlag, const ConnectorPairHash * ratsnestGraph = NULL);
 	void clearRatsnestDisplay(QList<ConnectorItem *> & connectorItems);
 	bool marked();
 	void setMarked(bool);
@@ -208,7 +209,7 @@ protected:
 
 protected:
 	QPointer<Connector> m_connector;
-	QList< QPointer<ConnectorItem> > m_connectedTo;
+	ConnectorItemList m_connectedTo;
 	QPointF m_terminalPoint;
 	QPointer<ConnectorItem> m_overConnectorItem;
 	bool m_connectorHovering;
@@ -250,6 +251,7 @@ public:
 	static bool isGrounded(ConnectorItem * c1, ConnectorItem * c2);
 	static void collectConnectorNames(QList<ConnectorItem *> & connectorItems, QStringList & connectorNames);
 	static class Wire * directlyWiredTo(ConnectorItem * source, ConnectorItem * target, ViewGeometry::WireFlags flags);
+	static ViewGeometry::WireFlags ratsnestSkipFlags(ViewGeometry::WireFlags myFlag);
 
 public:
 	static const QList<ConnectorItem *> emptyConnectorItemList;
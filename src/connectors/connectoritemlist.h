@@ -0,0 +1,138 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef CONNECTORITEMLIST_H
+#define CONNECTORITEMLIST_H
+
+#include <QtGlobal>
+#include <QList>
+#include <string.h>
+
+class ConnectorItem;
+
+// Holds the items a ConnectorItem is connected to.  Almost every connector has zero, one or two connections,
+// so the first few raw pointers live inline and the list only touches the heap for busier connectors.
+// The pointers are not guarded: connections are always made and broken in pairs,
+// and ~ConnectorItem removes itself from every item it is connected to, so nothing dangles.
+// const_iterator is a plain pointer, which keeps foreach and indexed loops free of allocation.
+
+class ConnectorItemList
+{
+public:
+	typedef ConnectorItem * const * const_iterator;
+
+	ConnectorItemList() : m_data(m_inline), m_count(0), m_capacity(InlineCount) {
+	}
+
+	ConnectorItemList(const ConnectorItemList & other) : m_data(m_inline), m_count(0), m_capacity(InlineCount) {
+		copyFrom(other);
+	}
+
+	~ConnectorItemList() {
+		if (m_data != m_inline) qFree(m_data);
+	}
+
+	ConnectorItemList & operator=(const ConnectorItemList & other) {
+		if (this != &other) {
+			m_count = 0;
+			copyFrom(other);
+		}
+		return *this;
+	}
+
+	const_iterator begin() const { return m_data; }
+	const_iterator end() const { return m_data + m_count; }
+	int count() const { return m_count; }
+	int size() const { return m_count; }
+	bool isEmpty() const { return m_count == 0; }
+	ConnectorItem * at(int i) const { return m_data[i]; }
+	ConnectorItem * operator[](int i) const { return m_data[i]; }
+
+	int indexOf(const ConnectorItem * connectorItem) const {
+		for (int i = 0; i < m_count; i++) {
+			if (m_data[i] == connectorItem) return i;
+		}
+		return -1;
+	}
+
+	bool contains(const ConnectorItem * connectorItem) const {
+		return indexOf(connectorItem) >= 0;
+	}
+
+	void append(ConnectorItem * connectorItem) {
+		reserve(m_count + 1);
+		m_data[m_count++] = connectorItem;
+	}
+
+	void removeAt(int i) {
+		memmove(m_data + i, m_data + i + 1, (m_count - i - 1) * sizeof(ConnectorItem *));
+		m_count--;
+	}
+
+	bool removeOne(const ConnectorItem * connectorItem) {
+		int i = indexOf(connectorItem);
+		if (i < 0) return false;
+
+		removeAt(i);
+		return true;
+	}
+
+	QList<ConnectorItem *> toList() const {
+		QList<ConnectorItem *> list;
+		list.reserve(m_count);
+		for (int i = 0; i < m_count; i++) list.append(m_data[i]);
+		return list;
+	}
+
+protected:
+	void reserve(int count) {
+		if (count <= m_capacity) return;
+
+		int capacity = qMax(count, m_capacity * 2);
+		ConnectorItem ** data = (ConnectorItem **) qMalloc(capacity * sizeof(ConnectorItem *));
+		memcpy(data, m_data, m_count * sizeof(ConnectorItem *));
+		if (m_data != m_inline) qFree(m_data);
+		m_data = data;
+		m_capacity = capacity;
+	}
+
+	void copyFrom(const ConnectorItemList & other) {
+		reserve(other.m_count);
+		memcpy(m_data, other.m_data, other.m_count * sizeof(ConnectorItem *));
+		m_count = other.m_count;
+	}
+
+protected:
+	enum { InlineCount = 4 };
+
+	ConnectorItem * m_inline[InlineCount];
+	ConnectorItem ** m_data;
+	int m_count;
+	int m_capacity;
+};
+
+#endif
@@ -167,6 +167,70 @@ void ErcData::writeVoltage(QDomElement & parent, QDomDocument & doc) {
 	}
 }
 
+bool ErcData::writeToStream(QXmlStreamWriter & streamWriter) {
+	// same output as writeToElement, for exports that don't build a dom
+	switch (m_eType) {
+		case Ground:
+			streamWriter.writeStartElement("erc");
+			streamWriter.writeAttribute("etype", "ground");
+			writeCurrent(streamWriter);
+			break;
+		case VCC:
+			streamWriter.writeStartElement("erc");
+			streamWriter.writeAttribute("etype", "VCC");
+			writeCurrent(streamWriter);
+			writeVoltage(streamWriter);
+			break;
+		default:
+			return false;
+	}
+
+	streamWriter.writeEndElement();
+	return true;
+}
+
+void ErcData::writeCurrent(QXmlStreamWriter & streamWriter) {
+	if (m_current.isValid() || m_currentMin.isValid() || m_currentMax.isValid() || m_currentFlow != UnknownFlow) {
+		streamWriter.writeStartElement("current");
+		if (m_current.isValid()) {
+			streamWriter.writeAttribute("value", QString::number(m_current.value()));
+		}
+		if (m_currentMin.isValid()) {
+			streamWriter.writeAttribute("valueMin", QString::number(m_currentMin.value()));
+		}
+		if (m_currentMax.isValid()) {
+			streamWriter.writeAttribute("valueMax", QString::number(m_currentMax.value()));
+		}
+		switch (m_currentFlow) {
+			case Source:
+				streamWriter.writeAttribute("flow", "source");
+				break;
+			case Sink:
+				streamWriter.writeAttribute("flow", "sink");
+				break;
+			default:
+				break;
+		}
+		streamWriter.writeEndElement();
+	}
+}
+
+void ErcData::writeVoltage(QXmlStreamWriter & streamWriter) {
+	if (m_voltage.isValid() || m_voltageMin.isValid() || m_voltageMax.isValid()) {
+		streamWriter.writeStartElement("voltage");
+		if (m_voltage.isValid()) {
+			streamWriter.writeAttribute("value", QString::number(m_voltage.value()));
+		}
+		if (m_voltageMin.isValid()) {
+			streamWriter.writeAttribute("valueMin", QString::number(m_voltageMin.value()));
+		}
+		if (m_voltageMax.isValid()) {
+			streamWriter.writeAttribute("valueMax", QString::number(m_voltageMax.value()));
+		}
+		streamWriter.writeEndElement();
+	}
+}
+
 ErcData::EType ErcData::eType() {
 	return m_eType;
 }
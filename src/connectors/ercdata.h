@@ -29,6 +29,7 @@ $Date: 2011-07-30 12:17:22 -0700 (Sat, 30 Jul 2011) $
 
 #include <QString>
 #include <QDomElement>
+#include <QXmlStreamWriter>
 #include <QHash>
 #include <QList>
 
@@ -72,12 +73,15 @@ public:
 	ErcData(const QDomElement & ercElement);
 
 	bool writeToElement(QDomElement & ercElement, QDomDocument & doc);
+	bool writeToStream(QXmlStreamWriter &);
 	EType eType();
 	Ignore ignore();
 
 protected:
 	void readVoltage(QDomElement &);
 	void readCurrent(QDomElement &);
+	void writeCurrent(QXmlStreamWriter &);
+	void writeVoltage(QXmlStreamWriter &);
 	void writeVoltage(QDomElement &, QDomDocument &);
 	void writeCurrent(QDomElement &, QDomDocument &);
 	
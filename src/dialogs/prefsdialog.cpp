@@ -115,6 +115,7 @@ void PrefsDialog::initGeneral(QWidget * widget, QFileInfoList & list)
 	vLayout->addWidget(createColorForm());
 	vLayout->addWidget(createZoomerForm());
 	vLayout->addWidget(createAutosaveForm());
+	vLayout->addWidget(createSketchCacheForm());
 
 #ifndef QT_NO_DEBUG
 	vLayout->addWidget(createOtherForm());
@@ -228,6 +229,24 @@ QWidget * PrefsDialog::createAutosaveForm() {
 	return autosave;
 }
 
+QWidget * PrefsDialog::createSketchCacheForm() {
+	QGroupBox * sketchCache = new QGroupBox(tr("Loading"), this );
+
+	QHBoxLayout * zhlayout = new QHBoxLayout();
+	zhlayout->setSpacing(5);
+
+	QSettings settings;
+	QCheckBox * box = new QCheckBox(tr("Keep a copy of recently saved sketches so they reopen faster"));
+	box->setChecked(settings.value("sketchCache", true).toBool());
+	zhlayout->addWidget(box);
+
+	sketchCache->setLayout(zhlayout);
+
+	connect(box, SIGNAL(clicked(bool)), this, SLOT(toggleSketchCache(bool)));
+
+	return sketchCache;
+}
+
 
 QWidget * PrefsDialog::createLanguageForm(QFileInfoList & list) 
 {
@@ -406,6 +425,10 @@ void PrefsDialog::changeAutosavePeriod(int value) {
 	m_settings.insert("autosavePeriod", QString("%1").arg(value));
 }
 
+void PrefsDialog::toggleSketchCache(bool checked) {
+	m_settings.insert("sketchCache", QString("%1").arg(checked));
+}
+
 QWidget * PrefsDialog::createGridSizeForm(ViewInfoThing * viewInfoThing)
 {
 	QGroupBox * over = new QGroupBox(tr("Align-to-Grid size"), this);
@@ -74,6 +74,7 @@ protected:
 	QWidget* createColorForm();
 	QWidget * createZoomerForm();
 	QWidget * createAutosaveForm();
+	QWidget * createSketchCacheForm();
 	void updateWheelText();
 	void initGeneral(QWidget * general, QFileInfoList & list);
 	void initBreadboard(QWidget *, ViewInfoThing *);
@@ -92,6 +93,7 @@ protected slots:
 	void changeWheelBehavior();
 	void toggleAutosave(bool);
 	void changeAutosavePeriod(int);
+	void toggleSketchCache(bool);
 	void units(bool);
 	void restoreDefault();
 	void setBackgroundColor();
@@ -62,6 +62,10 @@ $Date: 2012-03-28 03:13:01 -0700 (Wed, 28 Mar 2012) $
 #include "lib/qtsysteminfo/QtSystemInfo.h"
 #include "processeventblocker.h"
 #include "autoroute/cmrouter/panelizer.h"
+#include "autoroute/cmrouter/cmrouter.h"
+#include "sketch/pcbsketchwidget.h"
+#include "utils/graphicsutils.h"
+#include "utils/tracespan.h"
 
 // dependency injection :P
 #include "referencemodel/sqlitereferencemodel.h"
@@ -81,6 +85,7 @@ $Date: 2012-03-28 03:13:01 -0700 (Wed, 28 Mar 2012) $
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QMultiHash>
+#include <QTime>
 
 static QNetworkAccessManager * NetworkAccessManager = NULL;
 
@@ -105,6 +110,10 @@ static QNetworkAccessManager * NetworkAccessManager = NULL;
 #ifndef QT_NO_DEBUG
 #define WIN_DEBUG
 #endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
 #endif
 
 int FApplication::RestartNeeded = 9999;
@@ -115,6 +124,86 @@ QMultiHash<QString, QString> InstalledFonts::InstalledFontsNameMapper;   // fami
 static const double LoadProgressStart = 0.085;
 static const double LoadProgressEnd = 0.6;
 
+static const uint BenchmarkSeed = 1;
+static const int BenchmarkCycles = 10;
+
+struct BenchmarkResult {
+	QString sketch;
+	QString stage;
+	int ms;
+	qint64 peakKB;
+};
+
+static qint64 peakResidentKB()
+{
+	// peak for the whole process so far, so it never goes down from one stage to the next
+#ifdef Q_WS_WIN
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+
+	return counters.PeakWorkingSetSize / 1024;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+
+#ifdef Q_WS_MAC
+	return usage.ru_maxrss / 1024;			// bytes on the mac
+#else
+	return usage.ru_maxrss;					// kilobytes on linux
+#endif
+#endif
+}
+
+static void benchmarkStage(QList<BenchmarkResult> & results, const QString & sketch, const QString & stage, QTime & timer)
+{
+	BenchmarkResult result;
+	result.sketch = sketch;
+	result.stage = stage;
+	result.ms = timer.elapsed();
+	result.peakKB = peakResidentKB();
+	results.append(result);
+	DebugDialog::debug(QString("benchmark %1 %2: %3 ms, %4 KB").arg(sketch).arg(stage).arg(result.ms).arg(result.peakKB));
+	timer.restart();
+}
+
+static QString jsonString(const QString & string) 
+{
+	QString escaped = string;
+	escaped.replace("\\", "\\\\");
+	escaped.replace("\"", "\\\"");
+	return "\"" + escaped + "\"";
+}
+
+static bool writeBenchmarkReport(const QString & fileName, const QList<BenchmarkResult> & results)
+{
+	// one row per sketch and stage, so two reports can be diffed or joined on (sketch, stage)
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+
+	QTextStream out(&file);
+	out.setCodec("UTF-8");
+	if (fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+		out << "sketch,stage,ms,peakKB\n";
+		foreach (BenchmarkResult result, results) {
+			out << TextUtils::csvField(result.sketch) << "," << result.stage << "," << result.ms << "," << result.peakKB << "\n";
+		}
+	}
+	else {
+		out << "{\n\"version\": " << jsonString(Version::versionString()) << ",\n";
+		out << "\"seed\": " << BenchmarkSeed << ",\n\"cycles\": " << BenchmarkCycles << ",\n\"results\": [\n";
+		for (int i = 0; i < results.count(); i++) {
+			const BenchmarkResult & result = results.at(i);
+			out << QString("{\"sketch\": %1, \"stage\": %2, \"ms\": %3, \"peakKB\": %4}%5\n")
+				.arg(jsonString(result.sketch)).arg(jsonString(result.stage)).arg(result.ms).arg(result.peakKB)
+				.arg(i < results.count() - 1 ? "," : "");
+		}
+		out << "]\n}\n";
+	}
+
+	file.close();
+	return true;
+}
+
 //////////////////////////
 
 FApplication::FApplication( int & argc, char ** argv) : QApplication(argc, argv)
@@ -205,6 +294,20 @@ bool FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-bom", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--bom", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = BomService;
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-benchmark", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--benchmark", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = BenchmarkService;
+			m_outputFolder = m_arguments[i + 1];			// the report file
+			toRemove << i << i + 1;
+		}
+
 		if ((m_arguments[i].compare("-p", Qt::CaseInsensitive) == 0) ||
 			(m_arguments[i].compare("-panel", Qt::CaseInsensitive) == 0)||
 			(m_arguments[i].compare("--panel", Qt::CaseInsensitive) == 0)) {
@@ -223,6 +326,12 @@ bool FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-trace", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--trace", Qt::CaseInsensitive) == 0)) {
+			TraceSpan::start(m_arguments[i + 1]);
+			toRemove << i << i + 1;
+		}
+
 		if (m_arguments[i].compare("-ep", Qt::CaseInsensitive) == 0) {
 			m_externalProcessPath = m_arguments[i + 1];
 			toRemove << i << i + 1;
@@ -502,6 +611,10 @@ int FApplication::serviceStartup() {
 			runGerberService();
 			return 0;
 
+		case BomService:
+			runBomService();
+			return 0;
+
 		case PanelizerService:
 			runPanelizerService();
 			return 0;
@@ -514,6 +627,10 @@ int FApplication::serviceStartup() {
 			runExampleService();
 			return 0;
 
+		case BenchmarkService:
+			runBenchmarkService();
+			return 0;
+
 		default:
 			DebugDialog::debug("unknown service");
 			return -1;
@@ -553,6 +670,43 @@ void FApplication::runGerberService()
 	}
 }
 
+void FApplication::runBomService()
+{
+	createUserDataStoreFolderStructure();
+
+	registerFonts();
+	loadReferenceModel();
+	if (!loadBin("")) {
+		return;
+	}
+
+	QDir dir(m_outputFolder);
+	QStringList filters;
+	filters << "*" + FritzingBundleExtension;
+	QStringList filenames = dir.entryList(filters, QDir::Files);
+	foreach (QString filename, filenames) {
+		QString filepath = dir.absoluteFilePath(filename);
+		QString basename = dir.absoluteFilePath(QFileInfo(filename).completeBaseName());
+		int loaded = 0;
+		MainWindow * mainWindow = loadWindows(loaded, false);
+		mainWindow->noBackup();
+		m_started = true;
+
+		FolderUtils::setOpenSaveFolderAux(m_outputFolder);
+		if (mainWindow->loadWhich(filepath, false, false, "")) {
+			if (!mainWindow->exportNetlist(basename + "_netlist.xml")) {
+				DebugDialog::debug(QString("unable to export netlist for %1").arg(filepath));
+			}
+			if (!mainWindow->exportBOM(basename + "_bom.csv")) {
+				DebugDialog::debug(QString("unable to export bom for %1").arg(filepath));
+			}
+		}
+
+		mainWindow->setCloseSilently(true);
+		mainWindow->close();
+	}
+}
+
 void FApplication::runGedaService() {
 	try {
 		QDir dir(m_outputFolder);
@@ -801,6 +955,8 @@ void FApplication::registerFont(const QString &fontFile, bool reallyRegister) {
 
 void FApplication::finish()
 {
+	TraceSpan::finish();
+
 	QString currVersion = Version::versionString();
 	QSettings settings;
     settings.setValue("version", currVersion);
@@ -894,6 +1050,11 @@ void FApplication::updatePrefs(PrefsDialog & prefsDialog)
 		else if (key.compare("autosaveEnabled") == 0) {
 			MainWindow::setAutosaveEnabled(hash.value(key).toInt());
 		}
+		else if (key.compare("sketchCache") == 0) {
+			foreach (MainWindow * mainWindow, mainWindows) {
+				mainWindow->setUseSketchCache(hash.value(key).toInt());
+			}
+		}
 		else if (key.contains("gridsize", Qt::CaseInsensitive)) {
 			foreach (MainWindow * mainWindow, mainWindows) {
 				foreach (SketchWidget * sketchWidget, mainWindow->sketchWidgets()) {
@@ -1523,6 +1684,145 @@ void FApplication::runExampleService(QDir & dir) {
 	}
 }
 
+void FApplication::runBenchmarkService()
+{	
+	m_started = true;
+
+	QList<BenchmarkResult> results;
+	QTime timer;
+	timer.start();
+
+	createUserDataStoreFolderStructure();
+	registerFonts();
+	loadReferenceModel();
+
+	if (!loadBin("")) {
+		DebugDialog::debug(QString("load bin failed"));
+		return;
+	}
+
+	benchmarkStage(results, "", "partsLoad", timer);
+
+	// CMRouter::setMaxCycles() saves the cycle count as the user's setting
+	QSettings settings;
+	QVariant maxCycles = settings.value("cmrouter/maxcycles");
+
+	QDir sketchesDir(FolderUtils::getApplicationSubFolderPath("sketches"));
+	runBenchmarkService(sketchesDir, results);
+
+	if (maxCycles.isValid()) settings.setValue("cmrouter/maxcycles", maxCycles);
+	else settings.remove("cmrouter/maxcycles");
+
+	if (!writeBenchmarkReport(m_outputFolder, results)) {
+		DebugDialog::debug(QString("unable to write benchmark report %1").arg(m_outputFolder));
+	}
+}
+
+void FApplication::runBenchmarkService(QDir & dir, QList<BenchmarkResult> & results) {
+	// same walk as runExampleService, but each sketch goes through the expensive pcb operations
+	// and nothing is saved; exports go to a scratch folder
+
+	QDir sketchesDir(FolderUtils::getApplicationSubFolderPath("sketches"));
+	QDir exportDir(QDir::temp().absoluteFilePath("fritzing_benchmark"));
+	exportDir.mkpath(exportDir.absolutePath());
+
+	QStringList nameFilters;
+	nameFilters << ("*" + FritzingBundleExtension);
+	QFileInfoList fileList = dir.entryInfoList(nameFilters, QDir::Files | QDir::NoSymLinks);
+	foreach (QFileInfo fileInfo, fileList) {
+		QString path = fileInfo.absoluteFilePath();
+		QString sketch = sketchesDir.relativeFilePath(path);
+		DebugDialog::debug("benchmark sketch " + path);
+
+		QTime timer;
+		timer.start();
+
+		int loaded = 0;
+		MainWindow * mainWindow = loadWindows(loaded, false);
+		if (mainWindow == NULL) continue;
+
+		mainWindow->noBackup();
+		FolderUtils::setOpenSaveFolderAux(exportDir.absolutePath());
+
+		if (!mainWindow->loadWhich(path, false, false, "")) {
+			DebugDialog::debug(QString("failed to load"));
+			mainWindow->setCloseSilently(true);
+			mainWindow->close();
+			continue;
+		}
+
+		benchmarkStage(results, sketch, "open", timer);
+
+		mainWindow->showPCBView();
+		PCBSketchWidget * pcbSketchWidget = mainWindow->pcbView();
+		pcbSketchWidget->setDisplayMessageBoxes(false);			// anything that would prompt goes to the debug log instead
+		RoutingStatus routingStatus;
+		routingStatus.zero();
+		pcbSketchWidget->updateRoutingStatus(routingStatus, true);
+		benchmarkStage(results, sketch, "routingStatus", timer);
+
+		// the remaining stages need a single board to work on
+		if (pcbSketchWidget->findBoard().count() == 1) {
+			CMRouter * cmRouter = new CMRouter(pcbSketchWidget);
+			cmRouter->setDisplayMessageBoxes(false);
+			QString message;
+			cmRouter->drc(message);
+			cmRouter->drcClean();
+			delete cmRouter;
+			benchmarkStage(results, sketch, "drc", timer);
+
+			if (routingStatus.m_netCount > 0) {
+				qsrand(BenchmarkSeed);
+				pcbSketchWidget->scene()->clearSelection();
+				pcbSketchWidget->setIgnoreSelectionChangeEvents(true);
+				cmRouter = new CMRouter(pcbSketchWidget);
+				cmRouter->setDisplayMessageBoxes(false);
+				cmRouter->setMaxCycles(BenchmarkCycles);
+				cmRouter->start();
+				delete cmRouter;
+				pcbSketchWidget->setIgnoreSelectionChangeEvents(false);
+				benchmarkStage(results, sketch, "autoroute", timer);
+			}
+
+			mainWindow->groundFill();
+			benchmarkStage(results, sketch, "groundFill", timer);
+		}
+
+		LayerList viewLayerIDs;
+		foreach (ViewLayer * viewLayer, pcbSketchWidget->viewLayers()) {
+			if (viewLayer == NULL) continue;
+			if (!viewLayer->visible()) continue;
+
+			viewLayerIDs << viewLayer->viewLayerID();
+		}
+		QSizeF imageSize;
+		bool empty;
+		QString svg = pcbSketchWidget->renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, false, imageSize, NULL, GraphicsUtils::StandardFritzingDPI, false, false, false, empty);
+		QFile file(exportDir.absoluteFilePath(fileInfo.completeBaseName() + ".svg"));
+		if (file.open(QIODevice::WriteOnly)) {
+			QTextStream out(&file);
+			out.setCodec("UTF-8");
+			out << svg;
+			file.close();
+		}
+		benchmarkStage(results, sketch, "svgExport", timer);
+
+		if (pcbSketchWidget->findBoard().count() == 1) {
+			mainWindow->exportToGerber(exportDir.absolutePath());
+			benchmarkStage(results, sketch, "gerberExport", timer);
+		}
+
+		mainWindow->setCloseSilently(true);
+		mainWindow->close();
+	}
+
+	QFileInfoList dirList = dir.entryInfoList(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks);
+	foreach (QFileInfo dirInfo, dirList) {
+		QDir dir(dirInfo.filePath());
+		runBenchmarkService(dir, results);
+	}
+}
+
 void FApplication::cleanFzzs() {
 	QHash<QString, LockedFile *> lockedFiles;
 	QString folder;
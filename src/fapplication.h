@@ -91,10 +91,13 @@ protected:
 	void runKicadFootprintService();
 	void runKicadSchematicService();
 	void runGerberService();
+	void runBomService();
 	void runPanelizerService();
 	void runInscriptionService();
 	void runExampleService();
 	void runExampleService(QDir &);
+	void runBenchmarkService();
+	void runBenchmarkService(QDir &, QList<struct BenchmarkResult> &);
 	QList<class MainWindow *> recoverBackups();
 	QList<MainWindow *> loadLastOpenSketch();
 	void doLoadPrevious(MainWindow *);
@@ -115,6 +118,8 @@ protected:
 		KicadSchematicService,
 		KicadFootprintService,
 		ExampleService,
+		BenchmarkService,
+		BomService,
 		NoService
 	};
 
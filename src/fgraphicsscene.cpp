@@ -31,9 +31,12 @@ $Date: 2011-12-05 09:07:55 -0800 (Mon, 05 Dec 2011) $
 
 #include <QToolTip>
 
+static const double LowDetailPixels = 2.5;			// items smaller than this on the device are left out of low detail renders
+
 FGraphicsScene::FGraphicsScene( QObject * parent) : QGraphicsScene(parent)
 {
     m_displayHandles = true;
+	m_lowDetail = false;
 	//setItemIndexMethod(QGraphicsScene::NoIndex);
 }
 
@@ -95,4 +98,20 @@ bool FGraphicsScene::displayHandles() {
     return m_displayHandles;
 }
 
+void FGraphicsScene::setLowDetail(bool lowDetail) {
+	m_lowDetail = lowDetail;
+}
+
+bool FGraphicsScene::lowDetail() {
+	return m_lowDetail;
+}
+
+bool FGraphicsScene::skipLowDetail(const QGraphicsItem * item, const QPainter * painter) {
+	FGraphicsScene * fscene = qobject_cast<FGraphicsScene *>(item->scene());
+	if (fscene == NULL || !fscene->m_lowDetail) return false;
+
+	QRectF r = painter->worldTransform().mapRect(item->boundingRect());
+	return r.width() < LowDetailPixels && r.height() < LowDetailPixels;
+}
+
 
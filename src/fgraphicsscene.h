@@ -42,10 +42,16 @@ public:
 	QPointF lastContextMenuPos();
     void setDisplayHandles(bool);
     bool displayHandles();
+	void setLowDetail(bool);
+	bool lowDetail();
+
+public:
+	static bool skipLowDetail(const QGraphicsItem *, const QPainter *);
 
 protected:
 	QPointF m_lastContextMenuPos;
     bool m_displayHandles;
+	bool m_lowDetail;
 
 };
 
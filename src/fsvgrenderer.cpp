@@ -35,6 +35,7 @@ $Date: 2012-04-07 02:02:13 -0700 (Sat, 07 Apr 2012) $
 #include <QPainter>
 #include <QCoreApplication>
 #include <QGraphicsSvgItem>
+#include <QtConcurrentMap>
 #include <qnumeric.h>
 
 QString FSvgRenderer::NonConnectorName("nonconn");
@@ -42,11 +43,21 @@ QString FSvgRenderer::NonConnectorName("nonconn");
 QHash<QString, RendererHash *> FSvgRenderer::m_moduleIDRendererHash;
 QHash<QString, RendererHash * > FSvgRenderer::m_filenameRendererHash;
 QSet<RendererHash * > FSvgRenderer::m_deleted;
+QHash<QString, QByteArray> FSvgRenderer::m_prefetched;
 
 double FSvgRenderer::m_printerScale = 90.0;
 
 static ConnectorInfo VanillaConnectorInfo;
 
+static QByteArray readSvgFile(const QString & filename) {
+	QFile file(filename);
+	if (!file.open(QFile::ReadOnly | QFile::Text)) {
+		return QByteArray();
+	}
+
+	return file.readAll();
+}
+
 FSvgRenderer::FSvgRenderer(QObject * parent) : QSvgRenderer(parent)
 {
 	m_defaultSizeF = QSizeF(0,0);
@@ -95,20 +106,49 @@ QByteArray FSvgRenderer::loadSvg(const QString & filename, const QStringList & c
 		return QByteArray();
 	}
 
-    QFile file(filename);
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
-		return QByteArray();
+	QByteArray contents = m_prefetched.value(filename);
+	if (contents.isEmpty()) {
+		contents = readSvgFile(filename);
 	}
 
-	QByteArray contents = file.readAll();
-	file.close();
-
 	if (contents.length() <= 0) return QByteArray();
 
 	return loadAux(contents, filename, connectorIDs, terminalIDs, legIDs, setColor, colorElementID, findNonConnectors);
 
 }
 
+void FSvgRenderer::prefetch(const QStringList & filenames) {
+	// reads a batch of svg files on the thread pool, so the (gui thread) renderer setup that follows doesn't wait on the disk one file at a time
+	QStringList toRead;
+	foreach (QString filename, filenames) {
+		if (m_prefetched.contains(filename)) continue;
+		if (toRead.contains(filename)) continue;
+
+		toRead.append(filename);
+	}
+
+	QList<QByteArray> contents = QtConcurrent::blockingMapped< QList<QByteArray> >(toRead, readSvgFile);
+	for (int i = 0; i < toRead.count(); i++) {
+		if (contents.at(i).isEmpty()) continue;
+
+		m_prefetched.insert(toRead.at(i), contents.at(i));
+	}
+}
+
+QByteArray FSvgRenderer::prefetched(const QString & filename) {
+	return m_prefetched.value(filename);
+}
+
+void FSvgRenderer::clearPrefetched() {
+	m_prefetched.clear();
+}
+
+void FSvgRenderer::clearPrefetched(const QStringList & filenames) {
+	foreach (QString filename, filenames) {
+		m_prefetched.remove(filename);
+	}
+}
+
 bool FSvgRenderer::loadSvgString(const QString & svg) {
 	QByteArray byteArray(svg.toUtf8());
 	QByteArray result = loadSvg(byteArray, "");
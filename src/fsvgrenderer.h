@@ -78,6 +78,10 @@ public:
 	static void cleanup();
 	static QSizeF parseForWidthAndHeight(QXmlStreamReader &);
 	static void removeFromHash(const QString &moduleId, const QString filename);
+	static void prefetch(const QStringList & filenames);
+	static QByteArray prefetched(const QString & filename);
+	static void clearPrefetched();
+	static void clearPrefetched(const QStringList & filenames);
 
 protected:
 	bool determineDefaultSize(QXmlStreamReader &);
@@ -107,6 +111,7 @@ protected:
 	static QHash<QString, RendererHash * > m_filenameRendererHash;
 	static QHash<QString, RendererHash * > m_moduleIDRendererHash;
 	static QSet<RendererHash *> m_deleted;
+	static QHash<QString, QByteArray> m_prefetched;
 
 public:
 	static QString NonConnectorName;
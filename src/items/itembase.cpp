@@ -146,6 +146,7 @@ ItemBase::ItemBase( ModelPart* modelPart, ViewIdentifierClass::ViewIdentifier vi
 	m_hasRubberBandLeg = m_moveLock = m_hoverEnterSpaceBarWasPressed = m_spaceBarWasPressed = false;
 
 	m_moveLockItem = NULL;
+	m_busTableGeneration = -1;
 
 	m_everVisible = true;
 
@@ -173,6 +174,13 @@ ItemBase::ItemBase( ModelPart* modelPart, ViewIdentifierClass::ViewIdentifier vi
 
 ItemBase::~ItemBase() {
 	//DebugDialog::debug(QString("deleting itembase %1 %2 %3").arg((long) this, 0, 16).arg(m_id).arg((long) m_modelPart, 0, 16));
+
+	// deleted without a removeItem() first
+	InfoGraphicsView * infoGraphicsView = InfoGraphicsView::getInfoGraphicsView(this);
+	if (infoGraphicsView) {
+		infoGraphicsView->itemLeavingScene(this);
+	}
+
 	if (m_partLabel) {
 		delete m_partLabel;
 		m_partLabel = NULL;
@@ -248,6 +256,7 @@ ModelPart * ItemBase::modelPart() {
 
 void ItemBase::setModelPart(ModelPart * modelPart) {
 	m_modelPart = modelPart;
+	clearBusTable();
 }
 
 ModelPartShared * ItemBase::modelPartShared() {
@@ -506,6 +515,7 @@ void ItemBase::setHidden(bool hide) {
 	setAcceptedMouseButtons(m_hidden || m_inactive ? Qt::NoButton : ALLMOUSEBUTTONS);
 	setAcceptHoverEvents(!(m_hidden || m_inactive));
 	update();
+	geometryChanged();
 	foreach (QGraphicsItem * item, childItems()) {
 		NonConnectorItem * nonconnectorItem = dynamic_cast<NonConnectorItem *>(item);
 		if (nonconnectorItem == NULL) continue;
@@ -630,22 +640,40 @@ const QHash<QString, QPointer<Bus> > & ItemBase::buses() {
 
 void ItemBase::busConnectorItems(class Bus * bus, QList<class ConnectorItem *> & items) {
 	if (bus == NULL) return;
-
-	foreach (Connector * connector, bus->connectors()) {
-		QList< QPointer<ConnectorItem> > allConnectorItems = connector->viewItems();
-		foreach (ConnectorItem * connectorItem, allConnectorItems) {
-			if (connectorItem != NULL) {
-				//connectorItem->debugInfo(QString("on the bus %1").arg((long) connector, 0, 16));
-				if (connectorItem->attachedTo() == this) {
-					items.append(connectorItem);
+	if (m_modelPart == NULL) return;
+
+	if (m_busTableGeneration != m_modelPart->busGeneration()) {
+		// walking every connector's viewItems across all views is expensive on big buses (breadboard rails),
+		// so do it once for all buses and keep only the connectorItems attached to this item
+		m_busTable.clear();
+		foreach (Bus * b, m_modelPart->buses()) {
+			if (b == NULL) continue;
+
+			QVector<ConnectorItem *> & busItems = m_busTable[b];
+			foreach (Connector * connector, b->connectors()) {
+				foreach (ConnectorItem * connectorItem, connector->viewItems()) {
+					if (connectorItem != NULL && connectorItem->attachedTo() == this) {
+						busItems.append(connectorItem);
+					}
 				}
 			}
-			//else {
-				//DebugDialog::debug(QString("off the bus %1").arg((long) connector, 0, 16));
-			//}
+			busItems.squeeze();
 		}
+		m_busTableGeneration = m_modelPart->busGeneration();
 	}
 
+	QHash<Bus *, QVector<ConnectorItem *> >::const_iterator it = m_busTable.constFind(bus);
+	if (it == m_busTable.constEnd()) return;
+
+	const QVector<ConnectorItem *> & busItems = it.value();
+	for (int i = 0; i < busItems.count(); i++) {
+		items.append(busItems.at(i));
+	}
+}
+
+void ItemBase::clearBusTable() {
+	m_busTable.clear();
+	m_busTableGeneration = -1;
 }
 
 int ItemBase::itemType() const
@@ -815,6 +843,7 @@ ConnectorItem* ItemBase::newConnectorItem(Connector *connector)
 
 ConnectorItem* ItemBase::newConnectorItem(ItemBase * layerKin, Connector *connector) 
 {
+	layerKin->clearBusTable();
 	return new ConnectorItem(connector, layerKin);
 }
 
@@ -1081,6 +1110,20 @@ QVariant ItemBase::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
 				m_partLabel->ownerSelected(value.toBool());
 			}
 			
+			break;
+		case QGraphicsItem::ItemPositionHasChanged:
+		case QGraphicsItem::ItemTransformHasChanged:
+		case QGraphicsItem::ItemVisibleHasChanged:
+		case QGraphicsItem::ItemSceneHasChanged:
+			geometryChanged();
+			break;
+		case QGraphicsItem::ItemSceneChange:
+			if (value.value<QGraphicsScene *>() == NULL) {
+				InfoGraphicsView * infoGraphicsView = InfoGraphicsView::getInfoGraphicsView(this);
+				if (infoGraphicsView) {
+					infoGraphicsView->itemLeavingScene(this);
+				}
+			}
 			break;
 		default:
 			break;
@@ -1089,6 +1132,15 @@ QVariant ItemBase::itemChange(QGraphicsItem::GraphicsItemChange change, const QV
 	return QGraphicsSvgItem::itemChange(change, value);
 }
 
+void ItemBase::geometryChanged()
+{
+	// lets the view track what moved without rescanning the scene
+	InfoGraphicsView * infoGraphicsView = InfoGraphicsView::getInfoGraphicsView(this);
+	if (infoGraphicsView) {
+		infoGraphicsView->itemGeometryChanged(this);
+	}
+}
+
 void ItemBase::cleanup() {
 }
 
@@ -1827,6 +1879,7 @@ const QList<ConnectorItem *> & ItemBase::cachedConnectorItemsConst() const
 void ItemBase::clearConnectorItemCache() 
 {
 	m_cachedConnectorItems.clear();
+	clearBusTable();
 }
 
 void ItemBase::killRubberBandLeg() {
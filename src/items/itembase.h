@@ -36,6 +36,7 @@ $Date: 2012-04-07 15:47:10 -0700 (Sat, 07 Apr 2012) $
 #include <QPointer>
 #include <QUrl>
 #include <QMap>
+#include <QVector>
 #include <QTimer>
 #include <QCursor>
 
@@ -192,6 +193,7 @@ public:
 	void killRubberBandLeg();
 	bool sceneEvent(QEvent *event);
 	void clearConnectorItemCache();
+	void clearBusTable();
 	const QList<ConnectorItem *> & cachedConnectorItems();
 	const QList<ConnectorItem *> & cachedConnectorItemsConst() const;
 	bool inHover();
@@ -284,6 +286,7 @@ protected:
 	virtual void paintBody(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 
 	QVariant itemChange(QGraphicsItem::GraphicsItemChange change, const QVariant & value);
+	void geometryChanged();
 
 	virtual QStringList collectValues(const QString & family, const QString & prop, QString & value);
 
@@ -325,6 +328,8 @@ protected:
 	bool m_moveLock;
 	bool m_hasRubberBandLeg;
 	QList<ConnectorItem *> m_cachedConnectorItems;
+	QHash<class Bus *, QVector<ConnectorItem *> > m_busTable;		// this item's own connectorItems per bus
+	int m_busTableGeneration;
 	QGraphicsSvgItem * m_moveLockItem;
 
 protected:
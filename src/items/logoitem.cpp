@@ -391,6 +391,11 @@ void LogoItem::loadImage(const QString & fileName, bool addName)
 		GroundPlaneGenerator gpg;
 		gpg.setLayerName(layerName());
 		gpg.setMinRunSize(1, 1);
+		gpg.setTraceContours(true);
+		if (qobject_cast<CopperLogoItem *>(this) == NULL) {
+			// copper keeps the exact pixel outline: simplifying can move an edge into a clearance
+			gpg.setContourTolerance(GroundPlaneGenerator::contourToleranceSetting());
+		}
 		double res = image.dotsPerMeterX() / GraphicsUtils::InchesPerMeter;
 		gpg.scanImage(image, image.width(), image.height(), 1, res, colorString(), false, false, QSizeF(0, 0), 0, QPointF(0, 0));
 		QStringList newSvgs = gpg.newSVGs();
@@ -56,10 +56,57 @@ $Date: 2012-03-09 01:52:17 -0800 (Fri, 09 Mar 2012) $
 #include "led.h"
 #include "../utils/folderutils.h"
 #include "../utils/lockmanager.h"
+#include "../version/version.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QCoreApplication>
 
 static QString PartFactoryFolderPath;
 static QHash<QString, LockedFile *> LockedFiles;
 
+// Generated fzp and svg files are kept across sessions in a folder shared by every running copy of Fritzing.
+// A generated file depends on its name, which encodes the generator parameters (e.g. generic_ic_dip_8_300mil),
+// and on the generator code and templates, which are compiled into the executable. So entries are keyed by
+// the name inside a folder named for a hash of the build: a rebuild, even with the same version, starts a fresh folder.
+static const QString CacheFormat("2");
+static const int StaleCacheDays = 30;
+static const QString CacheStampName("laststarted");
+static const int MaxGeneratedPaths = 1000;
+static QString PartFactoryCachePath;
+static QCache<QString, QString> GeneratedPaths(MaxGeneratedPaths);		// cache key -> path, so repeat lookups skip the disk and the generator
+
+static QString buildKey() {
+	QFileInfo info(QCoreApplication::applicationFilePath());
+	QString inputs = QString("%1/%2/%3/%4")
+		.arg(Version::versionString())
+		.arg(CacheFormat)
+		.arg(info.size())
+		.arg(info.lastModified().toMSecsSinceEpoch());
+	QByteArray hash = QCryptographicHash::hash(inputs.toUtf8(), QCryptographicHash::Sha1);
+	return QString(hash.toHex().left(12));
+}
+
+static bool writeGenerated(const QString & path, const QString & contents) {
+	// write under a private name and rename, so another session never sees a half-written file
+	QString tempPath = path + "." + FolderUtils::getRandText();
+	QFile file(tempPath);
+	if (!file.open(QFile::WriteOnly)) return false;
+
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+	stream << contents;
+	file.close();
+
+	if (QFile::rename(tempPath, path)) return true;
+
+	// another session got there first
+	QFile::remove(tempPath);
+	return QFileInfo(path).exists();
+}
+
 ItemBase * PartFactory::createPart( ModelPart * modelPart, ViewLayer::ViewLayerSpec viewLayerSpec, ViewIdentifierClass::ViewIdentifier viewIdentifier, const ViewGeometry & viewGeometry, long id, QMenu * itemMenu, QMenu * wireMenu, bool doLabel)
 {
 	modelPart->setModelIndexFromMultiplied(id);			// make sure the model index is synched with the id; this is not always the case when parts are first created.
@@ -264,45 +311,43 @@ QString PartFactory::getSvgFilename(ModelPart * modelPart, const QString & expec
 
 QString PartFactory::getSvgFilenameAux(const QString & expectedFileName, QString (*getSvg)(const QString &))
 {
-	QString path = FolderUtils::getApplicationSubFolderPath("parts") + "/"+ ItemBase::SvgFilesDir + "/core/";
-	if (QFileInfo(path + expectedFileName).exists()) return expectedFileName;
+	// a remembered path isn't checked on disk: the cache folder belongs to this build and is stamped at startup,
+	// and other sessions only sweep folders that haven't been started with for StaleCacheDays
+	QString key = "svg/" + expectedFileName;
+	QString * cached = GeneratedPaths.object(key);
+	if (cached) return *cached;
 
-	path = PartFactoryFolderPath + "/svg/core/" + expectedFileName;
-	QFile file(path);
-	if (file.exists()) {
-		return path;
-	} 
+	QString path = FolderUtils::getApplicationSubFolderPath("parts") + "/"+ ItemBase::SvgFilesDir + "/core/";
+	if (QFileInfo(path + expectedFileName).exists()) {
+		// core svgs are remembered by bare name
+		GeneratedPaths.insert(key, new QString(expectedFileName));
+		return expectedFileName;
+	}
 
-	QString svg = (*getSvg)(expectedFileName);
-	if (file.open(QFile::WriteOnly)) {
-		QTextStream stream(&file);
-		stream.setCodec("UTF-8");
-		stream << svg;
-		file.close();
-		return path;
+	path = PartFactoryCachePath + "/svg/core/" + expectedFileName;
+	if (!QFileInfo(path).exists()) {
+		QString svg = (*getSvg)(expectedFileName);
+		if (!writeGenerated(path, svg)) return "";
 	}
 
-	return "";
+	GeneratedPaths.insert(key, new QString(path));
+	return path;
 }
 
 QString PartFactory::getFzpFilenameAux(const QString & moduleID, QString (*getFzp)(const QString &))
 {
-	QString path = PartFactoryFolderPath + "/core/" + moduleID + FritzingPartExtension;
-	QFile file(path);
-	if (file.exists()) {
-		return path;
+	QString key = "fzp/" + moduleID;
+	QString * cached = GeneratedPaths.object(key);
+	if (cached) return *cached;
+
+	QString path = PartFactoryCachePath + "/core/" + moduleID + FritzingPartExtension;
+	if (!QFileInfo(path).exists()) {
+		QString fzp = (*getFzp)(moduleID);
+		if (!writeGenerated(path, fzp)) return "";
 	}
 
-	QString fzp = (*getFzp)(moduleID);
-	if (file.open(QFile::WriteOnly)) {
-		QTextStream stream(&file);
-		stream.setCodec("UTF-8");
-		stream << fzp;
-		file.close();
-		return path;
-	}
-
-	return "";
+	GeneratedPaths.insert(key, new QString(path));
+	return path;
 }
 
 
@@ -350,6 +395,32 @@ void PartFactory::initFolder()
 	QFileInfoList backupList;
 	LockManager::checkLockedFiles("partfactory", backupList, LockedFiles, true, LockManager::SlowTime);
 	FolderUtils::makePartFolderHierarchy(PartFactoryFolderPath, "core");
+
+	// the shared cache lives outside the locked folders, which are swept as leftovers when their lock goes stale
+	QString version = QString("%1_%2").arg(Version::versionString()).arg(buildKey());
+	version.replace(QRegExp("[^\\w.]"), "_");
+	QDir cacheDir(FolderUtils::getUserDataStorePath("partfactorycache"));
+	cacheDir.mkpath(version);
+	PartFactoryCachePath = cacheDir.absoluteFilePath(version);
+
+	// a folder's own timestamp only changes when entries are added, so mark each startup in a stamp file
+	QFile stamp(PartFactoryCachePath + "/" + CacheStampName);
+	if (stamp.open(QFile::WriteOnly | QFile::Truncate)) {
+		stamp.write(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8());
+		stamp.close();
+	}
+
+	foreach (QFileInfo info, cacheDir.entryInfoList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
+		if (info.fileName() == version) continue;
+
+		// another installed version may still be using its cache, so only clear out ones it hasn't started with lately
+		QFileInfo stampInfo(info.filePath() + "/" + CacheStampName);
+		QDateTime lastUsed = stampInfo.exists() ? stampInfo.lastModified() : info.lastModified();
+		if (lastUsed < QDateTime::currentDateTime().addDays(-StaleCacheDays)) {
+			FolderUtils::rmdir(info.filePath());
+		}
+	}
+	FolderUtils::makePartFolderHierarchy(PartFactoryCachePath, "core");
 }
 
 void PartFactory::cleanup()
@@ -405,3 +476,7 @@ ModelPart * PartFactory::fixObsoleteModuleID(QDomDocument & domDocument, QDomEle
 QString PartFactory::folderPath() {
 	return PartFactoryFolderPath;
 }
+
+QString PartFactory::cacheFolderPath() {
+	return PartFactoryCachePath;
+}
@@ -43,6 +43,7 @@ public:
 	static void cleanup();
 	static class ModelPart * fixObsoleteModuleID(QDomDocument & domDocument, QDomElement & instance, QString & moduleIDRef, class ModelBase * referenceModel);
 	static QString folderPath();
+	static QString cacheFolderPath();
 
 
 
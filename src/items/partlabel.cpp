@@ -34,6 +34,7 @@ $Date: 2012-02-03 07:20:27 -0800 (Fri, 03 Feb 2012) $
 #include "../utils/textutils.h"
 #include "../installedfonts.h"
 #include "../fsvgrenderer.h"
+#include "../fgraphicsscene.h"
 
 #include <QGraphicsScene>
 #include <QMenu>
@@ -743,6 +744,7 @@ void PartLabel::partLabelEdit()
 void PartLabel::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
 	if (m_hidden) return;
+	if (FGraphicsScene::skipLowDetail(this, painter)) return;
 
 	if (m_inactive) {
 		painter->save();
@@ -90,6 +90,7 @@ later:
 #include "../utils/cursormaster.h"
 #include "../utils/ratsnestcolors.h"
 #include "../layerattributes.h"
+#include "../fgraphicsscene.h"
 
 #include <stdlib.h>
 
@@ -250,6 +251,14 @@ void Wire::initEnds(const ViewGeometry & vg, QRectF defaultRect, InfoGraphicsVie
 
 void Wire::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget ) {
 	if (m_hidden) return;
+	if (FGraphicsScene::skipLowDetail(this, painter)) {
+		// a wire is usually a chain of short segments; leaving the tiny ones out would break it up, so draw a hairline
+		QPen pen(m_pen);
+		pen.setWidth(0);
+		painter->setPen(pen);
+		painter->drawLine(line());
+		return;
+	}
 
 	ItemBase::paint(painter, option, widget);
 }
@@ -1592,6 +1601,7 @@ void Wire::setLine(const QLineF &line)
     prepareGeometryChange();
     m_line = line;
     update();
+	geometryChanged();
 }
 
 void Wire::setLine(double x1, double y1, double x2, double y2)
@@ -1618,11 +1628,15 @@ QPen Wire::pen() const
 */
 void Wire::setPen(const QPen &pen)
 {
-	if (pen.widthF() != m_pen.widthF()) {
+	bool widthChanged = (pen.widthF() != m_pen.widthF());
+	if (widthChanged) {
 		prepareGeometryChange();
 	}
     m_pen = pen;
     update();
+	if (widthChanged) {
+		geometryChanged();
+	}
 }
 
 bool Wire::canHaveCurve() {
@@ -1640,6 +1654,7 @@ void Wire::changeCurve(const Bezier * bezier)
 	if (m_bezier == NULL) m_bezier = new Bezier;
 	m_bezier->copy(bezier);
 	update();
+	geometryChanged();
 }
 
 bool Wire::isCurved() {
@@ -133,11 +133,22 @@ int main(int argc, char *argv[])
 				"[-kicad {path to folder containing Kicad footprint (.mod) files to be converted to Fritzing SVGs}]\n"
 				"[-kicadschematic {path to folder containing Kicad schematic (.lib) files to be converted to Fritzing SVGs}]\n"
 				"[-gerber {path to folder to export Gerber files into} {path to Fritzing file to be exported to Gerber}]\n"
+				"[-bom {path to folder of .fzz files to export netlists and BoMs for}]\n"
+				"[-benchmark {path to .json or .csv report file}]\n"
+				"[-trace {path to trace file}]\n"
 				"[-ep {external process path} [-eparg {argument passed to external process}]* -epname {name for the menu item}]\n"
 				"\n"
-				"The -geda/-kicad/-kicadschematic/-gerber options all exit Fritzing after the conversion process is complete;\n"
+				"The -geda/-kicad/-kicadschematic/-gerber/-bom options all exit Fritzing after the conversion process is complete;\n"
 				"these options are mutually exclusive.\n"
 				"\n"
+				"The -bom option writes {name}_netlist.xml and {name}_bom.csv next to each .fzz file in the folder.\n"
+				"\n"
+				"The -benchmark option opens every example sketch, times loading, routing status, DRC, autorouting (fixed seed and cycle count),\n"
+				"ground fill, SVG and Gerber export, and writes the time and peak memory of each step to the report file.\n"
+				"\n"
+				"The -trace option records how long loading, routing status, DRC, autorouting, fill and export take,\n"
+				"and writes them on exit as Chrome trace_event json (open it with chrome://tracing).\n"
+				"\n"
 				"Usually, the Fritzing executable is stored in the same folder that contains the parts/bins/sketches/translations folders,\n"
 				"or the executable is in a child folder of the p/b/s/t folder.\n"
 				"If this is not the case, use the -f option to point to the p/b/s/t folder.\n"
@@ -222,6 +222,7 @@ MainWindow::MainWindow(PaletteModel * paletteModel, ReferenceModel *refModel, QW
 	m_paletteModel = paletteModel;
 	m_refModel = refModel;
 	m_sketchModel = new SketchModel(true);
+	m_sketchModel->setUseSketchCache(settings.value("sketchCache", true).toBool());
 
 	m_tabWidget = new QStackedWidget(this); //   FTabWidget(this);
 	m_tabWidget->setObjectName("sketch_tabs");
@@ -1321,7 +1322,10 @@ void MainWindow::saveBundledNonAtomicEntity(QString &filename, const QString &ex
 
 void MainWindow::loadBundledSketch(const QString &fileName, bool addToRecent, bool setAsLastOpened) {
 
-	if(!FolderUtils::unzipTo(fileName, m_fzzFolder)) {
+	// the sketch is parsed from the copy kept in memory, but it is still extracted into m_fzzFolder,
+	// since saving the bundle and the backup handling work from that folder
+	QHash<QString, QByteArray> sketches;
+	if(!FolderUtils::unzipTo(fileName, m_fzzFolder, FritzingSketchExtension, sketches)) {
 		QMessageBox::warning(
 			this,
 			tr("Fritzing"),
@@ -1334,10 +1338,7 @@ void MainWindow::loadBundledSketch(const QString &fileName, bool addToRecent, bo
 	QDir dir(m_fzzFolder);
 	FolderUtils::makePartFolderHierarchy(m_fzzFolder, "contrib");
 
-	QStringList namefilters;
-	namefilters << "*"+FritzingSketchExtension;
-	QFileInfoList entryInfoList = dir.entryInfoList(namefilters);
-	if (entryInfoList.count() == 0) {
+	if (sketches.count() == 0) {
 		QMessageBox::warning(
 			this,
 			tr("Fritzing"),
@@ -1347,9 +1348,9 @@ void MainWindow::loadBundledSketch(const QString &fileName, bool addToRecent, bo
 		return;
 	}
 
-	QFileInfo sketchInfo = entryInfoList[0];
-
-	QString sketchName = dir.absoluteFilePath(sketchInfo.fileName());
+	QStringList sketchNames = sketches.keys();
+	qSort(sketchNames);
+	QString sketchName = dir.absoluteFilePath(sketchNames.first());
 
 	QList<ModelPart*> mps = moveToPartsFolder(dir, this, false, false, m_fzzFolder, "contrib");
 	foreach (ModelPart * mp, mps) {
@@ -1362,7 +1363,8 @@ void MainWindow::loadBundledSketch(const QString &fileName, bool addToRecent, bo
 	}
 
 	// the bundled itself
-	this->mainLoad(sketchName, "");
+	m_sketchModel->setSketchCacheSource(fileName);
+	this->mainLoad(sketchName, "", sketches.value(sketchNames.first()));
 	setCurrentFile(fileName, addToRecent, setAsLastOpened);
 }
 
@@ -2581,6 +2583,12 @@ void MainWindow::setReportMissingModules(bool b) {
 	}
 }
 
+void MainWindow::setUseSketchCache(bool b) {
+	if (m_sketchModel) {
+		m_sketchModel->setUseSketchCache(b);
+	}
+}
+
 void MainWindow::warnSMD(const QString & moduleID) {
 
 	ModelPart * mp = m_refModel->retrieveModelPart(moduleID);
@@ -86,7 +86,7 @@ public:
     MainWindow(QFile & fileToLoad);
 	~MainWindow();
 
-    void mainLoad(const QString & fileName, const QString & displayName);
+    void mainLoad(const QString & fileName, const QString & displayName, const QByteArray & fileContents = QByteArray());
 	bool loadWhich(const QString & fileName, bool setAsLastOpened, bool addToRecent, const QString & displayName);
 	void notClosableForAWhile();
 	QAction *raiseWindowAction();
@@ -121,9 +121,12 @@ public:
 	
 	void setCurrentFile(const QString &fileName, bool addToRecent, bool setAsLastOpened);
 	void setReportMissingModules(bool);
+	void setUseSketchCache(bool);
 	QList<SketchWidget *> sketchWidgets();
 	void setCloseSilently(bool);
 	void exportToGerber(const QString & outputDir);
+	bool exportNetlist(const QString & fileName);
+	bool exportBOM(const QString & fileName);
 	class PCBSketchWidget * pcbView();
 	void noBackup();
 	void swapSelectedAux(ItemBase * itemBase, const QString & moduleID);
@@ -310,6 +313,7 @@ protected slots:
 	void openProgramWindow();
 	void linkToProgramFile(const QString & filename, const QString & language, const QString & programmer, bool addLink, bool strong);
 	void designRulesCheck();
+	void liveDesignRulesCheck();
 	void subSwapSlot(SketchWidget *, ItemBase *, ViewLayer::ViewLayerSpec, QUndoCommand * parentCommand);
 	void updateLayerMenuSlot();
 	bool save();
@@ -441,6 +445,7 @@ protected:
 
 	QString getBoardSilkscreenSvg(ItemBase * board, int res, QSizeF & imageSize);
 	QString mergeBoardSvg(QString & svg, ItemBase * board, int res, QSizeF & imageSize, bool flip);
+	QString mergeBoardSvg(QString & svg, const QString & boardSvg, const QSizeF & boardImageSize, QSizeF & imageSize, bool flip);
 
 	bool wannaRestart();
 
@@ -453,6 +458,9 @@ protected:
 	class Wire * retrieveWire();
 	class ConnectorItem * retrieveConnectorItem();
 	QString getBomProps(ItemBase *);
+	void collectBomParts(QList<ItemBase *> & partList, QHash<ItemBase *, QString> & bomProps, SketchWidget *);
+	bool writeBOM(QIODevice &, bool csv, SketchWidget *);
+	void writeNetlist(QIODevice &, SketchWidget *);
 	ModelPart * findReplacedby(ModelPart * originalModelPart);
 	void groundFillAux(bool fillGroundTraces);
 	void connectStartSave(bool connect);
@@ -662,6 +670,7 @@ protected:
 	QAction *m_setGroundFillSeedsAct;
 	QAction *m_clearGroundFillSeedsAct;
 	QAction *m_designRulesCheckAct;
+	QAction *m_liveDesignRulesCheckAct;
 	QAction *m_autorouterSettingsAct;
 	QAction *m_tidyWiresAct;
 
@@ -28,6 +28,11 @@ $Date: 2012-04-14 04:12:19 -0700 (Sat, 14 Apr 2012) $
 #include <QSvgGenerator>
 #include <QColor>
 #include <QImageWriter>
+#include <QtConcurrentMap>
+#include <QFutureWatcher>
+#include <QEventLoop>
+#include <QBuffer>
+#include <QXmlStreamWriter>
 
 #include "mainwindow.h"
 #include "debugdialog.h"
@@ -76,6 +81,7 @@ static QString pdfActionType = ".pdf";
 static QString pngActionType = ".png";
 static QString svgActionType = ".svg";
 static QString bomActionType = ".html";
+static QString bomCsvActionType = ".csv";
 static QString netlistActionType = ".xml";
 
 static QHash<QString, QPrinter::OutputFormat> filePrintFormats;
@@ -84,6 +90,16 @@ static QHash<QString, QString> fileExtFormats;
 
 static QRegExp AaCc("[aAcC]");
 
+struct EtchableJob {
+	QString fileName;
+	QString svg;
+	QSizeF imageSize;
+	int res;
+	bool wantPDF;
+	QPrinter::OutputFormat format;
+	bool ok;
+};
+
 ////////////////////////////////////////////////////////
 
 bool sortPartList(ItemBase * b1, ItemBase * b2){
@@ -103,11 +119,53 @@ void massageOutput(QString & svg, bool doMask, bool doSilk, QString & maskTop, Q
 	}
 }
 
+void writeEtchable(EtchableJob & job)
+{
+	// may run on a worker thread: touches nothing but its own finished svg string; failures are reported by the caller
+	job.ok = false;
+	if (!job.wantPDF) {
+		QFile file(job.fileName);
+		if (!file.open(QIODevice::WriteOnly)) return;
+
+		QTextStream out(&file);
+		out.setCodec("UTF-8");
+		out << job.svg;
+		file.close();
+		job.ok = (file.error() == QFile::NoError);
+		return;
+	}
+
+	QPrinter printer(QPrinter::HighResolution);
+	printer.setOutputFormat(job.format);
+	printer.setOutputFileName(job.fileName);
+	int res = job.res;
+
+	// now convert to pdf
+	QSvgRenderer svgRenderer;
+	svgRenderer.load(job.svg.toLatin1());
+	double trueWidth = job.imageSize.width() / FSvgRenderer::printerScale();
+	double trueHeight = job.imageSize.height() / FSvgRenderer::printerScale();
+	QRectF target(0, 0, trueWidth * res, trueHeight * res);
+
+	QSizeF psize((target.width() + printer.paperRect().width() - printer.width()) / res, 
+				 (target.height() + printer.paperRect().height() - printer.height()) / res);
+	printer.setPaperSize(psize, QPrinter::Inch);
+
+	QPainter painter;
+	if (painter.begin(&printer))
+	{
+		svgRenderer.render(&painter, target);
+		job.ok = true;
+	}
+
+	painter.end();
+}
+
 /////////////////////////////////////////////////////////
 
 void MainWindow::initNames()
 {
-	OtherKnownExtensions << jpgActionType << psActionType << pdfActionType << pngActionType << svgActionType << bomActionType << netlistActionType;
+	OtherKnownExtensions << jpgActionType << psActionType << pdfActionType << pngActionType << svgActionType << bomActionType << bomCsvActionType << netlistActionType;
 
 	filePrintFormats[pdfActionType] = QPrinter::PdfFormat;
 	filePrintFormats[psActionType] = QPrinter::PostScriptFormat;
@@ -121,6 +179,7 @@ void MainWindow::initNames()
 	fileExtFormats[jpgActionType] = tr("JPEG Image (*.jpg)");
 	fileExtFormats[svgActionType] = tr("SVG Image (*.svg)");
 	fileExtFormats[bomActionType] = tr("BoM Text File (*.html)");
+	fileExtFormats[bomCsvActionType] = tr("BoM CSV File (*.csv)");
 
 	QSettings settings;
 	AutosaveEnabled = settings.value("autosaveEnabled", QString("%1").arg(AutosaveEnabled)).toBool();
@@ -198,8 +257,22 @@ void MainWindow::exportEtchable(bool wantPDF, bool wantSVG, bool flip)
 	FileProgressDialog * fileProgressDialog = exportProgress();
 
 
+	int res = GraphicsUtils::IllustratorDPI;
+	if (!wantSVG) {
+		QPrinter printer(QPrinter::HighResolution);
+		res = printer.resolution();
+	}
+
+	// the scene walk and svg splitting stay on the gui thread, but every layer shares one split cache
+	// and the board silkscreen is only rendered once; the finished files are written concurrently
+	m_pcbGraphicsView->beginRenderCache();
+
+	QSizeF boardImageSize;
+	QString boardSvg = getBoardSilkscreenSvg(board, res, boardImageSize);
+
 	QString maskTop, maskBottom;
 	QList<ItemBase *> copperLogoItems;
+	QList<EtchableJob> jobs;
 	for (int ix = 0; ix < fileNames.count(); ix++) {
 		bool doMask = false;
 		bool doSilk = false;
@@ -228,55 +301,54 @@ void MainWindow::exportEtchable(bool wantPDF, bool wantSVG, bool flip)
 			m_pcbGraphicsView->hideCopperLogoItems(copperLogoItems);
 		}
 
-		QSizeF imageSize;
-		if (wantSVG) {
-			bool empty;
-			QString svg = m_pcbGraphicsView->renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, imageSize, board, GraphicsUtils::IllustratorDPI, false, false, false, empty);
-			massageOutput(svg, doMask, doSilk, maskTop, maskBottom, fileName, GraphicsUtils::IllustratorDPI);		
-			svg = mergeBoardSvg(svg, board, GraphicsUtils::IllustratorDPI, imageSize, flip);
-			
-			QFile file(fileName);
-			file.open(QIODevice::WriteOnly);
-			QTextStream out(&file);
-			out.setCodec("UTF-8");
-			out << svg;
-			file.close();
-		}
-		else {
-			QPrinter printer(QPrinter::HighResolution);
-			printer.setOutputFormat(filePrintFormats[fileExt]);
-			printer.setOutputFileName(fileName);
-			int res = printer.resolution();
-			bool empty;
-			QString svg = m_pcbGraphicsView->renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, imageSize, board, res, false, false, false, empty);
-			massageOutput(svg, doMask, doSilk, maskTop, maskBottom, fileName, res);
-			svg = mergeBoardSvg(svg, board, res, imageSize, flip);
-			
-			// now convert to pdf
-			QSvgRenderer svgRenderer;
-			svgRenderer.load(svg.toLatin1());
-			double trueWidth = imageSize.width() / FSvgRenderer::printerScale();
-			double trueHeight = imageSize.height() / FSvgRenderer::printerScale();
-			QRectF target(0, 0, trueWidth * res, trueHeight * res);
-
-			QSizeF psize((target.width() + printer.paperRect().width() - printer.width()) / res, 
-						 (target.height() + printer.paperRect().height() - printer.height()) / res);
-			printer.setPaperSize(psize, QPrinter::Inch);
-
-			QPainter painter;
-			if (painter.begin(&printer))
-			{
-				svgRenderer.render(&painter, target);
-			}
+		EtchableJob job;
+		job.fileName = fileName;
+		job.res = res;
+		job.wantPDF = !wantSVG;
+		job.ok = false;
+		job.format = filePrintFormats.value(fileExt, QPrinter::PdfFormat);
+
+		bool empty;
+		QString svg = m_pcbGraphicsView->renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, job.imageSize, board, res, false, false, false, empty);
+		massageOutput(svg, doMask, doSilk, maskTop, maskBottom, fileName, res);
+		job.svg = mergeBoardSvg(svg, boardSvg, boardImageSize, job.imageSize, flip);
+		jobs.append(job);
 
-			painter.end();
-		}
 		if (doMask) {
 			m_pcbGraphicsView->restoreCopperLogoItems(copperLogoItems);
 		}
 
 	}
 
+	m_pcbGraphicsView->endRenderCache();
+
+	if (!wantSVG && !QFontDatabase::supportsThreadedFontRendering()) {
+		// pdf and postscript rendering draws text, which this platform only allows on the gui thread
+		for (int i = 0; i < jobs.count(); i++) {
+			writeEtchable(jobs[i]);
+		}
+	}
+	else {
+		QFutureWatcher<void> watcher;
+		QEventLoop eventLoop;
+		connect(&watcher, SIGNAL(finished()), &eventLoop, SLOT(quit()));
+		watcher.setFuture(QtConcurrent::map(jobs, writeEtchable));
+		if (!watcher.isFinished()) {
+			eventLoop.exec();
+		}
+		watcher.waitForFinished();
+	}
+
+	QStringList failed;
+	foreach (EtchableJob job, jobs) {
+		if (!job.ok) failed.append(job.fileName);
+	}
+	if (failed.count() > 0) {
+		delete fileProgressDialog;
+		QMessageBox::warning(this, tr("Fritzing"), tr("Unable to save %1").arg(failed.join(", ")) );
+		return;
+	}
+
 	m_statusBar->showMessage(tr("Sketch exported"), 2000);
 	delete fileProgressDialog;
 
@@ -351,6 +423,10 @@ void MainWindow::exportEtchable(bool wantPDF, bool wantSVG, bool flip)
 QString MainWindow::mergeBoardSvg(QString & svg, ItemBase * board, int res, QSizeF & imageSize, bool flip) {
 	QSizeF boardImageSize;
 	QString boardSvg = getBoardSilkscreenSvg(board, res, boardImageSize);
+	return mergeBoardSvg(svg, boardSvg, boardImageSize, imageSize, flip);
+}
+
+QString MainWindow::mergeBoardSvg(QString & svg, const QString & boardSvg, const QSizeF & boardImageSize, QSizeF & imageSize, bool flip) {
 	if (boardSvg.isEmpty()) return svg;
 
 	//QByteArray byteArray;
@@ -491,7 +567,9 @@ void MainWindow::exportAux(QString fileName, QImage::Format format, bool removeB
 	painter.begin(&image);
 	//m_currentGraphicsView->render(&painter);
 	QRectF target(0, 0, width, height);
+	m_currentGraphicsView->setLowDetailSuspended(true);
 	m_currentGraphicsView->scene()->render(&painter, target, source, Qt::KeepAspectRatio);
+	m_currentGraphicsView->setLowDetailSuspended(false);
 	painter.end();
 
 	if (removeBackground) {
@@ -566,6 +644,7 @@ void MainWindow::printAux(QPrinter &printer, bool removeBackground, bool paginat
 		item->setSelected(false);
 	}
 
+	m_currentGraphicsView->setLowDetailSuspended(true);
 	if (paginate) {
 		int xPages = qCeil(target.width() / printer.width());
 		int yPages = qCeil(target.height() / printer.height());
@@ -593,6 +672,7 @@ void MainWindow::printAux(QPrinter &printer, bool removeBackground, bool paginat
 	else {
 		m_currentGraphicsView->scene()->render(&painter, target, source, Qt::KeepAspectRatio);
 	}
+	m_currentGraphicsView->setLowDetailSuspended(false);
 
 	foreach(QGraphicsItem *item, selItems) {
 		item->setSelected(true);
@@ -687,9 +767,10 @@ void MainWindow::saveAsAuxAux(const QString & fileName) {
 	}
 
 	QString fzName = dir.absoluteFilePath(QFileInfo(fileName).completeBaseName() + FritzingSketchExtension); 
-	m_sketchModel->save(fzName, false);
+	m_sketchModel->save(fzName, false, true);
 
 	saveAsShareable(fileName, false);
+	m_sketchModel->writeSketchCache(fileName);
 
 	connectStartSave(false);
 
@@ -936,38 +1017,102 @@ void MainWindow::exportBOM() {
         return;
     }
 
-	QString bomTemplate;
-	QFile file(":/resources/templates/bom.html");
-	if (file.open(QFile::ReadOnly)) {
-		bomTemplate = file.readAll();
-		file.close();
-	}
-	else {
+    QString path = defaultSaveFolder();
+
+    QString fileExt;
+    QString extFmt = fileExtFormats.value(bomActionType) + ";;" + fileExtFormats.value(bomCsvActionType);
+    QString fname = path+"/"+constructFileName("bom", bomActionType);
+    DebugDialog::debug(QString("fname %1\n%2").arg(fname).arg(extFmt));
+
+    QString fileName = FolderUtils::getSaveFileName(this,
+            tr("Export Bill of Materials (BoM)..."),
+            fname,
+            extFmt,
+            &fileExt
+    );
+
+    if (fileName.isEmpty()) {
+		return; //Cancel pressed
+    }
+
+	FileProgressDialog * fileProgressDialog = exportProgress();
+    DebugDialog::debug(fileExt+" selected to export");
+	bool csv = alreadyHasExtension(fileName, bomCsvActionType) || (fileExt.compare(fileExtFormats.value(bomCsvActionType)) == 0);
+	QString suffix = csv ? bomCsvActionType : bomActionType;
+    if(!alreadyHasExtension(fileName, suffix)) {
+		fileName += suffix;
+    }
+
+	// build it in memory as well, since the text also goes on the clipboard
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	if (!writeBOM(buffer, csv, m_currentGraphicsView)) {
+		delete fileProgressDialog;
 		return;
 	}
+	buffer.close();
 
-	QString bomRowTemplate;
-	QFile file2(":/resources/templates/bom_row.html");
-	if (file2.open(QFile::ReadOnly)) {
-		bomRowTemplate = file2.readAll();
-		file2.close();
+	QString bom = QString::fromUtf8(buffer.data());
+
+    QFile fp(fileName);
+   	if (fp.open(QIODevice::WriteOnly)) {
+		fp.write(buffer.data());
+		fp.close();
 	}
 	else {
-		return;
+		QMessageBox::warning(this, tr("Fritzing"), tr("Unable to save BOM file, but the text is on the clipboard."));
 	}
 
-    QList <ItemBase*> partList;
-    QMap<QString, int> shoppingList;
-	QHash<QString, ItemBase *> descrs;
+	if (fp.exists() && !csv) {
+		QDesktopServices::openUrl(QString("file:///%1").arg(fileName));
+	}
+
+	QClipboard *clipboard = QApplication::clipboard();
+	if (clipboard != NULL) {
+		clipboard->setText(bom);
+	}
+	delete fileProgressDialog;
+}
 
-	m_currentGraphicsView->collectParts(partList);
+bool MainWindow::exportBOM(const QString & fileName) {
+	// headless: always from breadboard view, rather than whichever view the sketch happened to be saved in
+	if (m_breadboardGraphicsView == NULL) return false;
+
+	QFile fp(fileName);
+	if (!fp.open(QIODevice::WriteOnly)) return false;
+
+	bool result = writeBOM(fp, alreadyHasExtension(fileName, bomCsvActionType), m_breadboardGraphicsView);
+	fp.close();
+	return result;
+}
+
+void MainWindow::collectBomParts(QList<ItemBase *> & partList, QHash<ItemBase *, QString> & bomProps, SketchWidget * sketchWidget) {
+	sketchWidget->collectParts(partList);
 
     qSort(partList.begin(), partList.end(), sortPartList);
 
+	for (int i = partList.count() - 1; i >= 0; i--) {
+		if (partList.at(i)->itemType() != ModelPart::Part) {
+			partList.removeAt(i);
+		}
+	}
+
+	// getBomProps builds a widget per property, so only ask once per part
 	foreach (ItemBase * itemBase, partList) {
-		if (itemBase->itemType() != ModelPart::Part) continue;
+		bomProps.insert(itemBase, getBomProps(itemBase));
+	}
+}
 
-        QString desc = getBomProps(itemBase);
+bool MainWindow::writeBOM(QIODevice & device, bool csv, SketchWidget * sketchWidget) {
+    QList <ItemBase*> partList;
+	QHash<ItemBase *, QString> bomProps;
+	collectBomParts(partList, bomProps, sketchWidget);
+
+    QMap<QString, int> shoppingList;
+	QHash<QString, ItemBase *> descrs;
+	QHash<QString, QStringList> labels;
+	foreach (ItemBase * itemBase, partList) {
+        QString desc = bomProps.value(itemBase);
 
         if(!shoppingList.contains(desc)) {
             shoppingList.insert(desc, 1);
@@ -976,14 +1121,49 @@ void MainWindow::exportBOM() {
         else {
             shoppingList[desc]++;
         }
+		labels[desc].append(itemBase->instanceTitle());
     }
 
+	QTextStream out(&device);
+	out.setCodec("UTF-8");
+
+	if (csv) {
+		// one row per distinct part, which is what purchasing systems import
+		out << "Quantity,Part,Properties,Labels\n";
+		QMapIterator<QString, int> it(shoppingList);
+		while (it.hasNext()) {
+			it.next();
+			out << it.value() << ","
+				<< TextUtils::csvField(descrs.value(it.key())->title()) << ","
+				<< TextUtils::csvField(it.key()) << ","
+				<< TextUtils::csvField(labels.value(it.key()).join(" ")) << "\n";
+		}
+		return true;
+	}
+
+	QString bomTemplate;
+	QFile file(":/resources/templates/bom.html");
+	if (file.open(QFile::ReadOnly)) {
+		bomTemplate = file.readAll();
+		file.close();
+	}
+	else {
+		return false;
+	}
+
+	QString bomRowTemplate;
+	QFile file2(":/resources/templates/bom_row.html");
+	if (file2.open(QFile::ReadOnly)) {
+		bomRowTemplate = file2.readAll();
+		file2.close();
+	}
+	else {
+		return false;
+	}
 
 	QString assemblyString;
 	foreach (ItemBase * itemBase, partList) {
-		if (itemBase->itemType() != ModelPart::Part) continue;
-
-		assemblyString += bomRowTemplate.arg(itemBase->instanceTitle()).arg(itemBase->title()).arg(getBomProps(itemBase));
+		assemblyString += bomRowTemplate.arg(itemBase->instanceTitle()).arg(itemBase->title()).arg(bomProps.value(itemBase));
     }
 
 	QString shoppingListString;
@@ -996,7 +1176,7 @@ void MainWindow::exportBOM() {
 		shoppingListString += bomRowTemplate.arg(it.value()).arg(itemBase->title()).arg(it.key());
     }
 
-	QString bom = bomTemplate
+	out << bomTemplate
 		.arg("Fritzing Bill of Materials")
 		.arg(QFileInfo(m_fwFilename).fileName())
 		.arg(m_fwFilename)
@@ -1005,16 +1185,19 @@ void MainWindow::exportBOM() {
 		.arg(shoppingListString)
 		.arg(QString("%1.%2.%3").arg(Version::majorVersion()).arg(Version::minorVersion()).arg(Version::minorSubVersion()));
 
+	return true;
+}
 
+void MainWindow::exportNetlist() {
     QString path = defaultSaveFolder();
 
     QString fileExt;
-    QString extFmt = fileExtFormats.value(bomActionType);
-    QString fname = path+"/"+constructFileName("bom", bomActionType);
-    DebugDialog::debug(QString("fname %1\n%2").arg(fname).arg(extFmt));
+    QString extFmt = fileExtFormats.value(netlistActionType);
+    QString fname = path + "/" +constructFileName("netlist", netlistActionType);
+    //DebugDialog::debug(QString("fname %1\n%2").arg(fname).arg(extFmt));
 
     QString fileName = FolderUtils::getSaveFileName(this,
-            tr("Export Bill of Materials (BoM)..."),
+            tr("Export Netlist..."),
             fname,
             extFmt,
             &fileExt
@@ -1025,139 +1208,95 @@ void MainWindow::exportBOM() {
     }
 
 	FileProgressDialog * fileProgressDialog = exportProgress();
-    DebugDialog::debug(fileExt+" selected to export");
-    if(!alreadyHasExtension(fileName, bomActionType)) {
-		fileName += bomActionType;
+    //DebugDialog::debug(fileExt + " selected to export");
+    if(!alreadyHasExtension(fileName, netlistActionType)) {
+		fileName += netlistActionType;
     }
 
-    QFile fp(fileName);
-   	if (fp.open(QIODevice::WriteOnly)) {
-   		QTextStream out(&fp);
-		out.setCodec("UTF-8");
-   		out << bom;
-		fp.close();
-	}
-	else {
-		QMessageBox::warning(this, tr("Fritzing"), tr("Unable to save BOM file, but the text is on the clipboard."));
-	}
+	// build it in memory as well, since the text also goes on the clipboard
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	writeNetlist(buffer, m_currentGraphicsView);
+	buffer.close();
 
-	if (fp.exists()) {
-		QDesktopServices::openUrl(QString("file:///%1").arg(fileName));
-	}
+    QFile fp( fileName );
+    fp.open(QIODevice::WriteOnly);
+    fp.write(buffer.data());
+    fp.close();
 
 	QClipboard *clipboard = QApplication::clipboard();
 	if (clipboard != NULL) {
-		clipboard->setText(bom);
+		clipboard->setText(QString::fromUtf8(buffer.data()));
 	}
 	delete fileProgressDialog;
+
+
 }
 
-void MainWindow::exportNetlist() {
+bool MainWindow::exportNetlist(const QString & fileName) {
+	// headless: always from breadboard view, like exportBOM(fileName)
+	if (m_breadboardGraphicsView == NULL) return false;
+
+	QFile fp(fileName);
+	if (!fp.open(QIODevice::WriteOnly)) return false;
+
+	writeNetlist(fp, m_breadboardGraphicsView);
+	fp.close();
+	return true;
+}
+
+void MainWindow::writeNetlist(QIODevice & device, SketchWidget * sketchWidget) {
 	QHash<ConnectorItem *, int> indexer;
 	QList< QList<ConnectorItem *>* > netList;
-	this->m_currentGraphicsView->collectAllNets(indexer, netList, true, m_currentGraphicsView->boardLayers() > 1);
+	sketchWidget->collectAllNets(indexer, netList, true, sketchWidget->boardLayers() > 1);
 
-	QDomDocument doc;
-	doc.setContent(QString("<?xml version='1.0' encoding='UTF-8'?>\n") + TextUtils::CreatedWithFritzingXmlComment);
-	QDomElement netlist = doc.createElement("netlist");
-	doc.appendChild(netlist);
-	netlist.setAttribute("sketch", QFileInfo(m_fwFilename).fileName());
-    netlist.setAttribute("date", QDateTime::currentDateTime().toString());
+	QXmlStreamWriter streamWriter(&device);
+	streamWriter.setAutoFormatting(true);
+	streamWriter.writeStartDocument();
+	streamWriter.writeComment(" " + TextUtils::CreatedWithFritzingString + " ");
+	streamWriter.writeStartElement("netlist");
+	streamWriter.writeAttribute("sketch", QFileInfo(m_fwFilename).fileName());
+	streamWriter.writeAttribute("date", QDateTime::currentDateTime().toString());
 
-	// TODO: filter out 'ignore' connectors
-
-	QList< QList<ConnectorItem *>* > deleteNets;
 	foreach (QList<ConnectorItem *> * net, netList) {
-		QList<ConnectorItem *> deleteItems;
+		// filter out 'ignore' connectors
+		QList<ConnectorItem *> keepItems;
 		foreach (ConnectorItem * connectorItem, *net) {
 			ErcData * ercData = connectorItem->connectorSharedErcData();
-			if (ercData == NULL) continue;
-
-			if (ercData->ignore() == ErcData::Always) {
-				deleteItems.append(connectorItem);
-			}
-			else if ((ercData->ignore() == ErcData::IfUnconnected) && (net->count() == 1)) {
-				deleteItems.append(connectorItem);
+			if (ercData != NULL) {
+				if (ercData->ignore() == ErcData::Always) continue;
+				if ((ercData->ignore() == ErcData::IfUnconnected) && (net->count() == 1)) continue;
 			}
-		}
 
-		foreach (ConnectorItem * connectorItem, deleteItems) {
-			net->removeOne(connectorItem);
+			keepItems.append(connectorItem);
 		}
-		if (net->count() == 0) {
-			deleteNets.append(net);
-		}
-	}
 
-	foreach (QList<ConnectorItem *> * net, deleteNets) {
-		netList.removeOne(net);
-	}
+		delete net;
+		if (keepItems.count() == 0) continue;
 
-	foreach (QList<ConnectorItem *> * net, netList) {
-		QDomElement netElement = doc.createElement("net");
-		netlist.appendChild(netElement);
-		foreach (ConnectorItem * connectorItem, *net) {
-			QDomElement connector = doc.createElement("connector");
-			netElement.appendChild(connector);
-			connector.setAttribute("id", connectorItem->connectorSharedID());
-			connector.setAttribute("name", connectorItem->connectorSharedName());
-			QDomElement part = doc.createElement("part");
-			connector.appendChild(part);
+		streamWriter.writeStartElement("net");
+		foreach (ConnectorItem * connectorItem, keepItems) {
+			streamWriter.writeStartElement("connector");
+			streamWriter.writeAttribute("id", connectorItem->connectorSharedID());
+			streamWriter.writeAttribute("name", connectorItem->connectorSharedName());
 			ItemBase * itemBase = connectorItem->attachedTo();
-			part.setAttribute("id", itemBase->id());
-			part.setAttribute("label", itemBase->instanceTitle());
-			part.setAttribute("title", itemBase->title());
+			streamWriter.writeStartElement("part");
+			streamWriter.writeAttribute("id", QString::number(itemBase->id()));
+			streamWriter.writeAttribute("label", itemBase->instanceTitle());
+			streamWriter.writeAttribute("title", itemBase->title());
+			streamWriter.writeEndElement();
 			ErcData * ercData = connectorItem->connectorSharedErcData();
 			if (ercData != NULL) {
-				QDomElement erc = doc.createElement("erc");
-				if (ercData->writeToElement(erc, doc)) {
-					connector.appendChild(erc);
-				}
+				ercData->writeToStream(streamWriter);
 			}
+			streamWriter.writeEndElement();
 		}
-	}
-
-	foreach (QList<ConnectorItem *> * net, netList) {
-		delete net;
+		streamWriter.writeEndElement();
 	}
 	netList.clear();
 
-    QString path = defaultSaveFolder();
-
-    QString fileExt;
-    QString extFmt = fileExtFormats.value(netlistActionType);
-    QString fname = path + "/" +constructFileName("netlist", netlistActionType);
-    //DebugDialog::debug(QString("fname %1\n%2").arg(fname).arg(extFmt));
-
-    QString fileName = FolderUtils::getSaveFileName(this,
-            tr("Export Netlist..."),
-            fname,
-            extFmt,
-            &fileExt
-    );
-
-    if (fileName.isEmpty()) {
-		return; //Cancel pressed
-    }
-
-	FileProgressDialog * fileProgressDialog = exportProgress();
-    //DebugDialog::debug(fileExt + " selected to export");
-    if(!alreadyHasExtension(fileName, netlistActionType)) {
-		fileName += netlistActionType;
-    }
-
-    QFile fp( fileName );
-    fp.open(QIODevice::WriteOnly);
-    fp.write(doc.toByteArray());
-    fp.close();
-
-	QClipboard *clipboard = QApplication::clipboard();
-	if (clipboard != NULL) {
-		clipboard->setText(doc.toByteArray());
-	}
-	delete fileProgressDialog;
-
-
+	streamWriter.writeEndElement();
+	streamWriter.writeEndDocument();
 }
 
 FileProgressDialog * MainWindow::exportProgress() {
@@ -51,6 +51,8 @@ $Date: 2012-04-12 10:58:05 -0700 (Thu, 12 Apr 2012) $
 #include "infoview/htmlinfoview.h"
 #include "utils/bendpointaction.h"
 #include "fgraphicsscene.h"
+#include "layerattributes.h"
+#include "model/modelpartshared.h"
 #include "utils/fileprogressdialog.h"
 #include "svg/svgfilesplitter.h"
 #include "version/version.h"
@@ -230,7 +232,35 @@ bool MainWindow::loadWhich(const QString & fileName, bool setAsLastOpened, bool
 	return result;
 }
 
-void MainWindow::mainLoad(const QString & fileName, const QString & displayName) {
+static void prefetchSvgs(QList<ModelPart *> & modelParts)
+{
+	// gather the svgs all three views are about to ask for, so they can be read in parallel up front
+	QSet<ModelPartShared *> visited;
+	QStringList filenames;
+	QList<ViewIdentifierClass::ViewIdentifier> viewIdentifiers;
+	viewIdentifiers << ViewIdentifierClass::BreadboardView << ViewIdentifierClass::SchematicView << ViewIdentifierClass::PCBView;
+	foreach (ModelPart * modelPart, modelParts) {
+		ModelPartShared * modelPartShared = modelPart->modelPartShared();
+		if (modelPartShared == NULL) continue;
+		if (visited.contains(modelPartShared)) continue;
+
+		visited.insert(modelPartShared);
+		foreach (ViewIdentifierClass::ViewIdentifier viewIdentifier, viewIdentifiers) {
+			QDomElement layers = LayerAttributes::getSvgElementLayers(modelPartShared->domDocument(), viewIdentifier);
+			QString image = layers.attribute("image");
+			if (image.isEmpty()) continue;
+
+			QString filename = ItemBase::getSvgFilename(modelPart, image);
+			if (!filename.isEmpty()) {
+				filenames.append(filename);
+			}
+		}
+	}
+
+	FSvgRenderer::prefetch(filenames);
+}
+
+void MainWindow::mainLoad(const QString & fileName, const QString & displayName, const QByteArray & fileContents) {
 
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setMaximum(200);
@@ -260,13 +290,15 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName)
 				this, SLOT(loadedViewsSlot(ModelBase *, QDomElement &)), Qt::DirectConnection);
 	connect(m_sketchModel, SIGNAL(loadedRoot(const QString &, ModelBase *, QDomElement &)),
 				this, SLOT(loadedRootSlot(const QString &, ModelBase *, QDomElement &)), Qt::DirectConnection);
-	m_sketchModel->load(fileName, m_paletteModel, modelParts);
+	m_sketchModel->load(fileName, m_paletteModel, modelParts, fileContents);
 	DebugDialog::debug("core loaded");
 	disconnect(m_sketchModel, SIGNAL(loadedViews(ModelBase *, QDomElement &)),
 				this, SLOT(loadedViewsSlot(ModelBase *, QDomElement &)));
 	disconnect(m_sketchModel, SIGNAL(loadedRoot(const QString &, ModelBase *, QDomElement &)),
 				this, SLOT(loadedRootSlot(const QString &, ModelBase *, QDomElement &)));
 
+	prefetchSvgs(modelParts);
+
 	ProcessEventBlocker::processEvents();
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setValue(155);
@@ -294,6 +326,12 @@ void MainWindow::mainLoad(const QString & fileName, const QString & displayName)
 	newIDs.clear();
 	m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, NULL, false, NULL, false, newIDs);
 
+	// all three views are built, so the per-instance xml can go
+	FSvgRenderer::clearPrefetched();
+	foreach (ModelPart * modelPart, modelParts) {
+		modelPart->setInstanceDomElement(QDomElement());
+	}
+
 	ProcessEventBlocker::processEvents();
 	if (m_fileProgressDialog) {
 		m_fileProgressDialog->setValue(198);
@@ -1132,6 +1170,7 @@ void MainWindow::createMenus()
 	m_pcbTraceMenu = menuBar()->addMenu(tr("&Routing"));
 	m_pcbTraceMenu->addAction(m_autorouteAct);
 	m_pcbTraceMenu->addAction(m_designRulesCheckAct);
+	m_pcbTraceMenu->addAction(m_liveDesignRulesCheckAct);
 	m_pcbTraceMenu->addAction(m_autorouterSettingsAct);
 
 	QMenu * groundFillMenu = m_pcbTraceMenu->addMenu(tr("Ground Fill"));
@@ -1674,6 +1713,8 @@ void MainWindow::updateTraceMenu() {
 	m_clearGroundFillSeedsAct->setEnabled(gfsEnabled);
 
 	m_designRulesCheckAct->setEnabled(true);
+	m_liveDesignRulesCheckAct->setEnabled(m_currentGraphicsView == m_pcbGraphicsView);
+	m_liveDesignRulesCheckAct->setChecked(m_pcbGraphicsView->liveDrc());
 	m_autorouterSettingsAct->setEnabled(m_currentGraphicsView == m_pcbGraphicsView);
 	m_updateRoutingStatusAct->setEnabled(true);
 }
@@ -2235,6 +2276,11 @@ void MainWindow::createTraceMenuActions() {
 	m_designRulesCheckAct->setShortcut(tr("Shift+Ctrl+D"));
 	connect(m_designRulesCheckAct, SIGNAL(triggered()), this, SLOT(designRulesCheck()));
 
+	m_liveDesignRulesCheckAct = new QAction(tr("Live Design Rules Check"), this);
+	m_liveDesignRulesCheckAct->setStatusTip(tr("Highlight parts and traces that are too close together while you edit"));
+	m_liveDesignRulesCheckAct->setCheckable(true);
+	connect(m_liveDesignRulesCheckAct, SIGNAL(triggered()), this, SLOT(liveDesignRulesCheck()));
+
 	m_autorouterSettingsAct = new QAction(tr("Autorouter settings..."), this);
 	m_autorouterSettingsAct->setStatusTip(tr("Set autorouting parameters..."));
 	connect(m_autorouterSettingsAct, SIGNAL(triggered()), this, SLOT(autorouterSettings()));
@@ -2343,6 +2389,10 @@ void MainWindow::autoroute() {
 
 	delete autorouter;
 
+	if (pcbSketchWidget->liveDrc()) {
+		pcbSketchWidget->setLiveDrc(true);
+	}
+
 	pcbSketchWidget->setLayerActive(ViewLayer::Copper1, copper1Active);
 	pcbSketchWidget->setLayerActive(ViewLayer::Copper0, copper0Active);
 	updateActiveLayerButtons();
@@ -3258,6 +3308,15 @@ void MainWindow::designRulesCheck()
 	}
 
 	cmRouter.drcClean();
+
+	if (pcbSketchWidget->liveDrc()) {
+		pcbSketchWidget->setLiveDrc(true);
+	}
+}
+
+void MainWindow::liveDesignRulesCheck() 
+{
+	m_pcbGraphicsView->setLiveDrc(m_liveDesignRulesCheckAct->isChecked());
 }
 
 void MainWindow::changeTraceLayer() {
@@ -30,15 +30,91 @@ $Date: 2012-03-19 12:11:41 -0700 (Mon, 19 Mar 2012) $
 #include "../items/moduleidnames.h"
 #include "../version/version.h"
 #include "../viewgeometry.h"
+#include "sketchcache.h"
+#include "../utils/tracespan.h"
 
 #include <QMessageBox>
+#include <QXmlStreamReader>
+#include <QBuffer>
 
+/////////////////////////////////////////////////
+
+static bool streamSketch(QXmlStreamReader & reader, QDomDocument & shell, QList<QDomElement> & instanceList, QString & errorStr, int & errorLine, int & errorColumn)
+{
+	// builds a small dom for everything but the <instance> elements; each instance becomes an element owned by
+	// the same document but left out of its tree, so no dom of the whole sketch is ever held, each instance
+	// is released on its own once nothing refers to it, and no instance pays for a document of its own
+
+	QList<QDomNode> stack;
+	bool inInstance = false;
+	while (!reader.atEnd()) {
+		switch (reader.readNext()) {
+			case QXmlStreamReader::StartElement:
+				{
+					bool instanceRoot = false;
+					if (!inInstance && stack.count() == 2 && reader.name() == QLatin1String("instance") && stack.last().nodeName() == "instances") {
+						inInstance = instanceRoot = true;
+					}
+					QDomElement element = reader.namespaceUri().isEmpty()
+						? shell.createElement(reader.name().toString())
+						: shell.createElementNS(reader.namespaceUri().toString(), reader.qualifiedName().toString());
+					foreach (QXmlStreamAttribute attribute, reader.attributes()) {
+						if (attribute.namespaceUri().isEmpty()) {
+							element.setAttribute(attribute.name().toString(), attribute.value().toString());
+						}
+						else {
+							element.setAttributeNS(attribute.namespaceUri().toString(), attribute.qualifiedName().toString(), attribute.value().toString());
+						}
+					}
+					if (stack.isEmpty()) {
+						shell.appendChild(element);
+					}
+					else if (!instanceRoot) {
+						stack.last().appendChild(element);
+					}
+					stack.append(element);
+				}
+				break;
+			case QXmlStreamReader::EndElement:
+				{
+					QDomNode node = stack.takeLast();
+					if (inInstance && stack.count() == 2) {
+						instanceList.append(node.toElement());
+						inInstance = false;
+					}
+				}
+				break;
+			case QXmlStreamReader::Characters:
+				if (stack.isEmpty() || reader.isWhitespace()) break;
+
+				if (reader.isCDATA()) {
+					stack.last().appendChild(shell.createCDATASection(reader.text().toString()));
+				}
+				else {
+					stack.last().appendChild(shell.createTextNode(reader.text().toString()));
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	if (reader.hasError()) {
+		errorStr = reader.errorString();
+		errorLine = (int) reader.lineNumber();
+		errorColumn = (int) reader.columnNumber();
+		return false;
+	}
+
+	return true;
+}
 
 /////////////////////////////////////////////////
 
 ModelBase::ModelBase( bool makeRoot )
 {
 	m_reportMissingModules = true;
+	m_useSketchCache = false;
 	m_referenceModel = NULL;
 	m_root = NULL;
 	if (makeRoot) {
@@ -62,24 +138,50 @@ ModelPart * ModelBase::retrieveModelPart(const QString & /* moduleID */)  {
 }
 
 // loads a model from an fz file--assumes a reference model exists with all parts
-bool ModelBase::load(const QString & fileName, ModelBase * refModel, QList<ModelPart *> & modelParts) {
-	m_referenceModel = refModel;
+// if fileContents is not empty, it is parsed instead of reading fileName (e.g. the .fz already read out of an .fzz)
+bool ModelBase::load(const QString & fileName, ModelBase * refModel, QList<ModelPart *> & modelParts, const QByteArray & fileContents) {
+	TraceSpan traceSpan("ModelBase::load");
 
-    QFile file(fileName);
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
-        QMessageBox::warning(NULL, QObject::tr("Fritzing"),
-                             QObject::tr("Cannot read file %1:\n%2.")
-                             .arg(fileName)
-                             .arg(file.errorString()));
-        return false;
-    }
+	m_referenceModel = refModel;
 
     QString errorStr;
-    int errorLine;
-    int errorColumn;
+    int errorLine = 0;
+    int errorColumn = 0;
     QDomDocument domDocument;
+	QList<QDomElement> instanceList;
+	bool parsed = false;
+
+	// the cache entry belongs to the file the user opened (the .fzz), which may not be fileName itself
+	QString cacheSource = m_sketchCacheSource.isEmpty() ? fileName : m_sketchCacheSource;
+	m_sketchCacheSource.clear();
+	if (m_useSketchCache) {
+		QByteArray fzHash;
+		parsed = SketchCache::read(cacheSource, domDocument, instanceList, fzHash);
+		if (parsed) {
+			DebugDialog::debug(QString("loaded %1 from sketch cache").arg(fileName));
+			SketchCache::verify(cacheSource, fileName, fileContents, fzHash);
+		}
+	}
+
+	if (!parsed) {
+		// without fileContents, parse straight from the file rather than reading it all into memory first
+		QFile file(fileName);
+		QXmlStreamReader reader;
+		if (fileContents.isEmpty()) {
+			if (!file.open(QFile::ReadOnly | QFile::Text)) {
+				QMessageBox::warning(NULL, QObject::tr("Fritzing"),
+									 QObject::tr("Cannot read file %1:\n%2.")
+									 .arg(fileName)
+									 .arg(file.errorString()));
+				return false;
+			}
+			reader.setDevice(&file);
+		}
+		else reader.addData(fileContents);
+		parsed = streamSketch(reader, domDocument, instanceList, errorStr, errorLine, errorColumn);
+	}
 
-    if (!domDocument.setContent(&file, true, &errorStr, &errorLine, &errorColumn)) {
+    if (!parsed) {
         QMessageBox::information(NULL, QObject::tr("Fritzing"),
                                  QObject::tr("Parse error (1) at line %1, column %2:\n%3\n%4")
                                  .arg(errorLine)
@@ -163,30 +265,24 @@ bool ModelBase::load(const QString & fileName, ModelBase * refModel, QList<Model
     	delete child;
    	}
 
-	emit loadingInstances(this, instances);
+	emit loadingInstances(this, instanceList.count());
 
 	if (checkForRats) {
-		QDomElement instance = instances.firstChildElement("instance");
-   		while (!instance.isNull()) {
-			QDomElement nextInstance = instance.nextSiblingElement("instance");
-			if (isRatsnest(instance)) {
-				instances.removeChild(instance);
+		for (int i = instanceList.count() - 1; i >= 0; i--) {
+			if (isRatsnest(instanceList[i])) {
+				instanceList.removeAt(i);
 			}
-			
-			instance = nextInstance;
 		}
 	}
 
 	if (checkForTraces) {
-		QDomElement instance = instances.firstChildElement("instance");
-   		while (!instance.isNull()) {
-			checkTraces(instance);
-			instance = instance.nextSiblingElement("instance");
+		for (int i = 0; i < instanceList.count(); i++) {
+			checkTraces(instanceList[i]);
 		}
 	}
 
-	bool result = loadInstances(domDocument, instances, modelParts);
-	emit loadedInstances(this, instances);
+	bool result = loadInstances(instanceList, modelParts);
+	emit loadedInstances(this, instanceList);
 	return result;
 }
 
@@ -196,10 +292,23 @@ ModelPart * ModelBase::fixObsoleteModuleID(QDomDocument & domDocument, QDomEleme
 
 bool ModelBase::loadInstances(QDomDocument & domDocument, QDomElement & instances, QList<ModelPart *> & modelParts)
 {
-	QHash<QString, QString> missingModules;
+	Q_UNUSED(domDocument);
+
+	QList<QDomElement> instanceList;
    	QDomElement instance = instances.firstChildElement("instance");
-   	ModelPart* modelPart = NULL;
    	while (!instance.isNull()) {
+		instanceList.append(instance);
+		instance = instance.nextSiblingElement("instance");
+	}
+
+	return loadInstances(instanceList, modelParts);
+}
+
+bool ModelBase::loadInstances(QList<QDomElement> & instanceList, QList<ModelPart *> & modelParts)
+{
+	QHash<QString, QString> missingModules;
+   	ModelPart* modelPart = NULL;
+	foreach (QDomElement instance, instanceList) {
 		emit loadingInstance(this, instance);
 
    		// for now assume all parts are in the palette
@@ -209,7 +318,6 @@ bool ModelBase::loadInstances(QDomDocument & domDocument, QDomElement & instance
 			mp->setInstanceText(instance.attribute("path"));
 			mp->setParent(m_root);
 			modelParts.append(mp);
-			instance = instance.nextSiblingElement("instance");
 			continue;
 		}
 
@@ -217,6 +325,7 @@ bool ModelBase::loadInstances(QDomDocument & domDocument, QDomElement & instance
    		modelPart = m_referenceModel->retrieveModelPart(moduleIDRef);
    		if (modelPart == NULL) {
 			DebugDialog::debug(QString("module id %1 not found in database").arg(moduleIDRef));
+			QDomDocument domDocument = instance.ownerDocument();
 			modelPart = fixObsoleteModuleID(domDocument, instance, moduleIDRef);
 			if (modelPart == NULL) {
 				if (genFZP(moduleIDRef, m_referenceModel)) {
@@ -224,7 +333,6 @@ bool ModelBase::loadInstances(QDomDocument & domDocument, QDomElement & instance
 				}
 				if (modelPart == NULL) {
 					missingModules.insert(moduleIDRef, instance.attribute("path"));
-   					instance = instance.nextSiblingElement("instance");
    					continue;
 				}
 			}
@@ -287,8 +395,6 @@ bool ModelBase::loadInstances(QDomDocument & domDocument, QDomElement & instance
 
 			prop = prop.nextSiblingElement("property");
 		}
-
-   		instance = instance.nextSiblingElement("instance");
   	}
 
 	if (m_reportMissingModules && missingModules.count() > 0) {
@@ -340,12 +446,20 @@ bool ModelBase::addPart(ModelPart * modelPart, bool update) {
 
 
 void ModelBase::save(const QString & fileName, bool asPart) {
+	save(fileName, asPart, false);
+}
+
+void ModelBase::save(const QString & fileName, bool asPart, bool writeSketchCache) {
+	bool cache = writeSketchCache && m_useSketchCache && !asPart;
+
 	QFileInfo info(fileName);
 	QDir dir = info.absoluteDir();
 
 	QString temp = dir.absoluteFilePath("temp.xml");
     QFile file1(temp);
-    if (!file1.open(QFile::WriteOnly | QFile::Text)) {
+	QIODevice::OpenMode openMode = QFile::WriteOnly;
+	if (!cache) openMode |= QFile::Text;
+    if (!file1.open(openMode)) {
         QMessageBox::warning(NULL, QObject::tr("Fritzing"),
                              QObject::tr("Cannot write file temp:\n%1\n%2\n%3.")
 							  .arg(temp)
@@ -355,8 +469,24 @@ void ModelBase::save(const QString & fileName, bool asPart) {
         return;
     }
 
-    QXmlStreamWriter streamWriter(&file1);
-	save(fileName, streamWriter, asPart);
+	QByteArray contents;
+	if (cache) {
+		// serialized in memory first, so the cache is built from the same bytes without reading the file back
+		QBuffer buffer(&contents);
+		buffer.open(QIODevice::WriteOnly);
+		QXmlStreamWriter streamWriter(&buffer);
+		save(fileName, streamWriter, asPart);
+		buffer.close();
+#ifdef Q_OS_WIN
+		// what QFile::Text does on the way out
+		contents.replace("\n", "\r\n");
+#endif
+		file1.write(contents);
+	}
+	else {
+		QXmlStreamWriter streamWriter(&file1);
+		save(fileName, streamWriter, asPart);
+	}
 	file1.close();
 	QFile original(fileName);
 	if(original.exists() && !original.remove()) {
@@ -372,6 +502,35 @@ void ModelBase::save(const QString & fileName, bool asPart) {
 		return;
 	}
 	file1.rename(fileName);
+
+	if (cache) {
+		// the entry is written by writeSketchCache() once the sketch file that holds this .fz is complete
+		m_sketchCacheContents = contents;
+		m_sketchCacheSaved = QDateTime::currentDateTime();
+	}
+}
+
+void ModelBase::writeSketchCache(const QString & sourcePath) {
+	QByteArray contents = m_sketchCacheContents;
+	m_sketchCacheContents.clear();
+	if (contents.isEmpty()) return;
+
+	// an older file means the bundle wasn't written, and the entry would describe the wrong bytes
+	QFileInfo info(sourcePath);
+	if (!info.exists() || info.lastModified().toTime_t() < m_sketchCacheSaved.toTime_t()) return;
+
+	QDomDocument shell;
+	QList<QDomElement> instanceList;
+	QString errorStr;
+	int errorLine, errorColumn;
+	QXmlStreamReader reader(contents);
+	if (streamSketch(reader, shell, instanceList, errorStr, errorLine, errorColumn)) {
+		SketchCache::write(sourcePath, SketchCache::hash(contents), shell, instanceList);
+	}
+}
+
+void ModelBase::setSketchCacheSource(const QString & sourcePath) {
+	m_sketchCacheSource = sourcePath;
 }
 
 void ModelBase::save(const QString & fileName, QXmlStreamWriter & streamWriter, bool asPart) {
@@ -491,6 +650,10 @@ void ModelBase::setReportMissingModules(bool b) {
 	m_reportMissingModules = b;
 }
 
+void ModelBase::setUseSketchCache(bool b) {
+	m_useSketchCache = b;
+}
+
 bool ModelBase::genFZP(const QString & moduleID, ModelBase * refModel) {
 	QString path = PartFactory::getFzpFilename(moduleID);
 	if (path.isEmpty()) return false;
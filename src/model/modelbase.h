@@ -28,6 +28,7 @@ $Date: 2012-03-19 12:11:41 -0700 (Mon, 19 Mar 2012) $
 #define MODELBASE_H
 
 #include <QObject>
+#include <QDateTime>
 #include "modelpart.h"
 
 class ModelBase : public QObject
@@ -42,27 +43,32 @@ public:
 	ModelPartSharedRoot * rootModelPartShared();
 	virtual ModelPart* retrieveModelPart(const QString & moduleID);
 	virtual ModelPart * addModelPart(ModelPart * parent, ModelPart * copyChild);
-	virtual bool load(const QString & fileName, ModelBase* refModel, QList<ModelPart *> & modelParts);
+	virtual bool load(const QString & fileName, ModelBase* refModel, QList<ModelPart *> & modelParts, const QByteArray & fileContents = QByteArray());
 	void save(const QString & fileName, bool asPart);
+	void save(const QString & fileName, bool asPart, bool writeSketchCache);
 	void save(const QString & fileName, class QXmlStreamWriter &, bool asPart);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference);
 	virtual bool addPart(ModelPart * modelPart, bool update);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference, bool updateIdAlreadyExists);
 	bool paste(ModelBase * refModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
 	void setReportMissingModules(bool);
+	void setUseSketchCache(bool);
+	void setSketchCacheSource(const QString & sourcePath);
+	void writeSketchCache(const QString & sourcePath);
 	bool genFZP(const QString & moduleID, ModelBase * refModel);
 	const QString & fritzingVersion();
 
 signals:
 	void loadedViews(ModelBase *, QDomElement & views);
 	void loadedRoot(const QString & fileName, ModelBase *, QDomElement & root);
-	void loadingInstances(ModelBase *, QDomElement & instances);
+	void loadingInstances(ModelBase *, int instanceCount);
 	void loadingInstance(ModelBase *, QDomElement & instance);
-	void loadedInstances(ModelBase *, QDomElement & instances);
+	void loadedInstances(ModelBase *, QList<QDomElement> & instanceList);
 
 protected:
 	void renewModelIndexes(QDomElement & root, const QString & childName, QHash<long, long> & oldToNew);
 	bool loadInstances(QDomDocument &, QDomElement & root, QList<ModelPart *> & modelParts);
+	bool loadInstances(QList<QDomElement> & instanceList, QList<ModelPart *> & modelParts);
 	ModelPart * fixObsoleteModuleID(QDomDocument & domDocument, QDomElement & instance, QString & moduleIDRef);
 	static bool isRatsnest(QDomElement & instance);
 	static void checkTraces(QDomElement & instance);
@@ -71,6 +77,10 @@ protected:
 	QPointer<ModelPart> m_root;
 	QPointer<ModelBase> m_referenceModel;
 	bool m_reportMissingModules;
+	bool m_useSketchCache;
+	QString m_sketchCacheSource;
+	QByteArray m_sketchCacheContents;
+	QDateTime m_sketchCacheSaved;
 	QString m_fritzingVersion;
 };
 
@@ -71,6 +71,7 @@ void ModelPart::commonInit(ItemType type) {
 	m_type = type;
 	m_locationFlags = 0;
 	m_indexSynched = false;
+	m_busGeneration = 0;
 }
 
 ModelPart::~ModelPart() {
@@ -415,6 +416,7 @@ void ModelPart::clearBuses() {
 		delete bus;
 	}
 	m_busHash.clear();
+	m_busGeneration++;
 }
 
 void ModelPart::initBuses() {
@@ -430,6 +432,11 @@ void ModelPart::initBuses() {
 			bus->addConnector(connector);
 		}
 	}
+	m_busGeneration++;
+}
+
+int ModelPart::busGeneration() const {
+	return m_busGeneration;
 }
 
 const QHash<QString, QPointer<Connector> > & ModelPart::connectors() {
@@ -123,6 +123,7 @@ public:
 	QString family();
 
 	Bus * bus(const QString & busID);
+	int busGeneration() const;
 	bool ignoreTerminalPoints();
 
 	bool isCore();
@@ -194,6 +195,7 @@ protected:
 	QHash<QString, QPointer<Connector> > m_connectorHash;
 	QList< QPointer<Connector> > m_deletedConnectors;
 	QHash<QString, QPointer<Bus> > m_busHash;
+	int m_busGeneration;				// bumped whenever the buses are rebuilt, so ItemBase bus tables know to refresh
 	long m_index;						// only used at save time to identify model parts in the xml
 	QDomElement m_instanceDomElement;	// only used at load time (so far)
 
@@ -28,10 +28,21 @@ $Date: 2012-04-10 10:16:12 -0700 (Tue, 10 Apr 2012) $
 #include "../connectors/connectorshared.h"
 #include "../debugdialog.h"
 #include "../connectors/busshared.h"
+#include "../processeventblocker.h"
 
 #include <QHash>
+#include <QSet>
+#include <QTimer>
 #include <QMessageBox>
 
+static QSet<QString> InternPool;
+
+static const int MaxResidentDocuments = 200;			// lazily loaded fzp doms kept around before the least recently used are dropped
+static QSet<ModelPartShared *> ResidentDocuments;
+static qint64 DocumentUseTick = 0;
+static ModelPartShared * TrimReceiver = NULL;
+static const int TrimRetryInterval = 1000;				// ms to wait before trimming again when a sketch is still loading
+
 void copyPinAttributes(QDomElement & from, QDomElement & to)
 {
 	to.setAttribute("svgId", from.attribute("svgId"));
@@ -141,6 +152,26 @@ ModelPartShared::ModelPartShared(QDomDocument * domDocument, const QString & pat
 void ModelPartShared::commonInit() {
 	m_moduleID = "";
 	m_flippedSMD = m_connectorsInitialized = m_ignoreTerminalPoints = m_partlyLoaded = m_needsCopper1 = false;
+	m_documentReleasable = false;
+	m_documentUse = 0;
+}
+
+QString ModelPartShared::intern(const QString & string) {
+	// thousands of parts repeat the same property names and values ("family", "package", "voltage", ...);
+	// handing back the pooled copy lets them all share one implicitly shared buffer
+	if (string.isEmpty()) return string;
+
+	QSet<QString>::const_iterator it = InternPool.constFind(string);
+	if (it != InternPool.constEnd()) return *it;
+
+	InternPool.insert(string);
+	return string;
+}
+
+void ModelPartShared::internList(QStringList & list) {
+	for (int i = 0; i < list.count(); i++) {
+		list[i] = intern(list.at(i));
+	}
 }
 
 ModelPartShared::~ModelPartShared() {
@@ -159,6 +190,11 @@ ModelPartShared::~ModelPartShared() {
 	}
 	m_buses.clear();
 
+	forgetDocument();
+	if (TrimReceiver == this) {
+		TrimReceiver = NULL;
+	}
+
 	if (m_domDocument) {
 		delete m_domDocument;
 		m_domDocument = NULL;
@@ -168,7 +204,7 @@ ModelPartShared::~ModelPartShared() {
 void ModelPartShared::loadTagText(QDomElement parent, QString tagName, QString &field) {
 	QDomElement tagElement = parent.firstChildElement(tagName);
 	if (!tagElement.isNull()) {
-		field = tagElement.text();
+		field = intern(tagElement.text());
 	}
 }
 
@@ -176,7 +212,7 @@ void ModelPartShared::populateTags(QDomElement parent, QStringList &list) {
 	QDomElement tags = parent.firstChildElement("tags");
 	QDomElement tag = tags.firstChildElement("tag");
 	while (!tag.isNull()) {
-		list << tag.text();
+		list << intern(tag.text());
 		tag = tag.nextSiblingElement("tag");
 	}
 }
@@ -185,9 +221,9 @@ void ModelPartShared::populateProperties(QDomElement parent, QHash<QString,QStri
 	QDomElement properties = parent.firstChildElement("properties");
 	QDomElement prop = properties.firstChildElement("property");
 	while (!prop.isNull()) {
-		QString name = prop.attribute("name");
-		QString value = prop.text();
-		hash.insert(name.toLower().trimmed(),value);
+		QString name = intern(prop.attribute("name"));
+		QString value = intern(prop.text());
+		hash.insert(intern(name.toLower().trimmed()),value);
 		if (prop.attribute("showInLabel", "").compare("yes", Qt::CaseInsensitive) == 0) {
 			displayKeys.append(name);
 		}
@@ -200,6 +236,9 @@ void ModelPartShared::setDomDocument(QDomDocument * domDocument) {
 		delete m_domDocument;
 	}
 	m_domDocument = domDocument;
+
+	// handed in from outside (e.g. the parts editor), so it may not match the file any more
+	forgetDocument();
 }
 
 QDomDocument* ModelPartShared::domDocument() {
@@ -207,6 +246,7 @@ QDomDocument* ModelPartShared::domDocument() {
 		loadDocument();
 	}
 
+	m_documentUse = ++DocumentUseTick;
 	return m_domDocument;
 }
 
@@ -247,7 +287,7 @@ const QString & ModelPartShared::author() {
 }
 
 void ModelPartShared::setAuthor(QString author) {
-	m_author = author;
+	m_author = intern(author);
 }
 
 const QString & ModelPartShared::description() {
@@ -290,6 +330,7 @@ const QStringList & ModelPartShared::tags() {
 }
 void ModelPartShared::setTags(const QStringList &tags) {
 	m_tags = tags;
+	internList(m_tags);
 }
 
 QString ModelPartShared::family() {
@@ -297,7 +338,7 @@ QString ModelPartShared::family() {
 }
 
 void ModelPartShared::setFamily(const QString &family) {
-	m_properties.insert("family",family);
+	m_properties.insert(intern("family"),intern(family));
 }
 
 QHash<QString,QString> & ModelPartShared::properties() {
@@ -305,7 +346,12 @@ QHash<QString,QString> & ModelPartShared::properties() {
 }
 
 void ModelPartShared::setProperties(const QHash<QString,QString> &properties) {
-	m_properties = properties;
+	m_properties.clear();
+	QHash<QString,QString>::const_iterator it;
+	for (it = properties.constBegin(); it != properties.constEnd(); ++it) {
+		m_properties.insert(intern(it.key()), intern(it.value()));
+	}
+	m_properties.squeeze();
 	ensurePartNumberProperty();
 }
 
@@ -321,7 +367,7 @@ const QString & ModelPartShared::taxonomy() {
 }
 
 void ModelPartShared::setTaxonomy(QString taxonomy) {
-	m_taxonomy = taxonomy;
+	m_taxonomy = intern(taxonomy);
 }
 
 const QString & ModelPartShared::moduleID() {
@@ -436,7 +482,7 @@ void ModelPartShared::copy(ModelPartShared* other) {
 }
 
 void ModelPartShared::setProperty(const QString & key, const QString & value) {
-	m_properties.insert(key, value);
+	m_properties.insert(intern(key), intern(value));
 }
 
 const QString & ModelPartShared::replacedby() {
@@ -482,12 +528,21 @@ void ModelPartShared::loadDocument() {
 
 	//DebugDialog::debug("loading document " + m_moduleID);
 
-	QFile file(m_path);
+	// a released dom is reparsed from the bytes it was first read from: the file itself may have moved
+	// (parts from an .fzz live in a temporary folder) or been overwritten since
+	QByteArray bytes = m_documentBytes;
+	if (bytes.isEmpty()) {
+		QFile file(m_path);
+		if (file.open(QFile::ReadOnly)) {
+			bytes = file.readAll();
+		}
+	}
+
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
 	QDomDocument * doc = new QDomDocument();
-	if (!doc->setContent(&file, true, &errorStr, &errorLine, &errorColumn)) {
+	if (!doc->setContent(bytes, true, &errorStr, &errorLine, &errorColumn)) {
 		DebugDialog::debug(QString("ModelPartShared load document failed: %1 line:%2 col:%3 on file '%4'").arg(errorStr).arg(errorLine).arg(errorColumn).arg(m_path));
 		QMessageBox::critical(NULL, tr("Fritzing"), tr("Unable to parse '%1': %2: line %3 column %4.").arg(m_path).arg(errorStr).arg(errorLine).arg(errorColumn));
 		delete doc;
@@ -495,9 +550,63 @@ void ModelPartShared::loadDocument() {
 	else {
 		m_domDocument = doc;
 		flipSMDAnd();
+
+		// only a dom read straight from the file can be dropped again and reparsed later
+		m_documentBytes = bytes;
+		m_documentReleasable = true;
+		m_documentUse = ++DocumentUseTick;
+		ResidentDocuments.insert(this);
+		if (ResidentDocuments.count() > MaxResidentDocuments && TrimReceiver == NULL) {
+			// trim from the event loop, so no caller is still holding QDomElements from a dom we drop
+			TrimReceiver = this;
+			QTimer::singleShot(0, this, SLOT(trimDocuments()));
+		}
+	}
+}
+
+void ModelPartShared::trimDocuments() {
+	if (ProcessEventBlocker::isProcessing()) {
+		// a sketch load pumps events between its steps and is about to use these doms; wait until it's done
+		QTimer::singleShot(TrimRetryInterval, this, SLOT(trimDocuments()));
+		return;
+	}
+
+	TrimReceiver = NULL;
+
+	while (ResidentDocuments.count() > MaxResidentDocuments) {
+		ModelPartShared * oldest = NULL;
+		foreach (ModelPartShared * modelPartShared, ResidentDocuments) {
+			if (oldest == NULL || modelPartShared->m_documentUse < oldest->m_documentUse) {
+				oldest = modelPartShared;
+			}
+		}
+		if (oldest == NULL) break;
+
+		oldest->releaseDocument();
 	}
 }
 
+void ModelPartShared::releaseDocument() {
+	// connectors, buses, views and metadata were already pulled out of the dom;
+	// domDocument() reparses the kept bytes if the part is needed again (e.g. dropped or edited)
+	if (!m_documentReleasable) return;
+
+	QByteArray bytes = m_documentBytes;
+	forgetDocument();
+	m_documentBytes = bytes;
+	if (m_domDocument) {
+		delete m_domDocument;
+		m_domDocument = NULL;
+	}
+	m_partlyLoaded = true;
+}
+
+void ModelPartShared::forgetDocument() {
+	m_documentReleasable = false;
+	m_documentBytes.clear();
+	ResidentDocuments.remove(this);
+}
+
 void ModelPartShared::flipSMDAnd() {
 	QDomElement root = m_domDocument->documentElement();
 	QDomElement views = root.firstChildElement("views");
@@ -609,6 +718,9 @@ bool ModelPartShared::hasViewFor(ViewIdentifierClass::ViewIdentifier viewIdentif
 }
 
 void ModelPartShared::setHasViewFor(ViewIdentifierClass::ViewIdentifier viewIdentifier, ViewLayer::ViewLayerID viewLayerID) {
+	// flipSMDAnd() runs again each time a released dom is reparsed
+	if (m_hasViewFor.contains(viewIdentifier, viewLayerID)) return;
+
 	m_hasViewFor.insert(viewIdentifier, viewLayerID);
 }
 
@@ -679,6 +791,7 @@ const QStringList & ModelPartShared::displayKeys() {
 
 void ModelPartShared::setDisplayKeys(const QStringList & displayKeys) {
 	m_displayKeys = displayKeys;
+	internList(m_displayKeys);
 }
 
 void ModelPartShared::ensurePartNumberProperty() {
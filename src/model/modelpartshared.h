@@ -122,9 +122,18 @@ protected:
 	void populateProperties(QDomElement parent, QHash<QString,QString> &hash, QStringList & displayKeys);
 	void commonInit();
 	void loadDocument();
+	void releaseDocument();
+	void forgetDocument();
 	bool checkNeedsCopper1(QDomElement & copper0, QDomElement & copper1);
 	void ensurePartNumberProperty();
 
+protected slots:
+	void trimDocuments();
+
+public:
+	static QString intern(const QString &);
+	static void internList(QStringList &);
+
 public:
 	static const QString PartNumberPropertyName;
 
@@ -162,6 +171,9 @@ protected:
 	bool m_flippedSMD;
 	bool m_partlyLoaded;
 	bool m_needsCopper1;				// for converting pre-two-layer parts
+	bool m_documentReleasable;			// the dom came straight from m_path, so it can be dropped and reparsed
+	QByteArray m_documentBytes;			// what m_path held when the dom was read
+	qint64 m_documentUse;
 };
 
 class ModelPartSharedRoot : public ModelPartShared
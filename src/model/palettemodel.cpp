@@ -38,6 +38,7 @@ $Date: 2012-01-15 22:45:36 -0800 (Sun, 15 Jan 2012) $
 #include "../utils/folderutils.h"
 #include "../utils/textutils.h"
 #include "../items/moduleidnames.h"
+#include "../utils/tracespan.h"
 
 bool PaletteModel::CreateAllPartsBinFile = false;  // now generating the all parts bin in advance using a python script:  [fritzing]/part-gen-scripts/misc_scripts/genAllParts.py
 
@@ -131,6 +132,8 @@ void PaletteModel::updateOrAddModelPart(const QString & moduleID, ModelPart *new
 }
 
 void PaletteModel::loadParts(bool fastLoad) {
+	TraceSpan traceSpan("PaletteModel::loadParts");
+
 	QStringList nameFilters;
 	nameFilters << "*" + FritzingPartExtension;
 
@@ -0,0 +1,266 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#include "sketchcache.h"
+#include "../debugdialog.h"
+#include "../utils/folderutils.h"
+
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtConcurrentRun>
+
+const QString SketchCache::CacheExtension(".cache");
+
+static const quint32 CacheMagic = 0x465a5343;		// "FZSC"
+static const quint32 CacheVersion = 2;
+static const int MaxCacheEntries = 50;
+
+enum CacheNodeType {
+	CacheElement = 1,
+	CacheText,
+	CacheCDATA
+};
+
+static void writeNode(QDataStream & stream, const QDomNode & node)
+{
+	if (node.isCDATASection()) {
+		stream << (quint8) CacheCDATA << node.nodeValue();
+		return;
+	}
+
+	if (node.isText()) {
+		stream << (quint8) CacheText << node.nodeValue();
+		return;
+	}
+
+	QDomElement element = node.toElement();
+	stream << (quint8) CacheElement << element.namespaceURI() << element.nodeName();
+
+	QDomNamedNodeMap attributes = element.attributes();
+	stream << (quint32) attributes.count();
+	for (int i = 0; i < attributes.count(); i++) {
+		QDomNode attribute = attributes.item(i);
+		stream << attribute.namespaceURI() << attribute.nodeName() << attribute.nodeValue();
+	}
+
+	// comments and processing instructions aren't kept
+	QList<QDomNode> children;
+	for (QDomNode child = element.firstChild(); !child.isNull(); child = child.nextSibling()) {
+		if (child.isElement() || child.isText() || child.isCDATASection()) {
+			children.append(child);
+		}
+	}
+	stream << (quint32) children.count();
+	foreach (QDomNode child, children) {
+		writeNode(stream, child);
+	}
+}
+
+static QDomNode readNode(QDataStream & stream, QDomDocument & document)
+{
+	quint8 type;
+	stream >> type;
+	if (type == CacheText || type == CacheCDATA) {
+		QString value;
+		stream >> value;
+		if (type == CacheText) return document.createTextNode(value);
+
+		return document.createCDATASection(value);
+	}
+
+	if (type != CacheElement) {
+		stream.setStatus(QDataStream::ReadCorruptData);
+		return QDomNode();
+	}
+
+	QString namespaceURI, name;
+	stream >> namespaceURI >> name;
+	QDomElement element = namespaceURI.isEmpty() ? document.createElement(name) : document.createElementNS(namespaceURI, name);
+
+	quint32 count;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QString attributeURI, attributeName, value;
+		stream >> attributeURI >> attributeName >> value;
+		if (attributeURI.isEmpty()) element.setAttribute(attributeName, value);
+		else element.setAttributeNS(attributeURI, attributeName, value);
+	}
+
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QDomNode child = readNode(stream, document);
+		if (child.isNull()) break;
+
+		element.appendChild(child);
+	}
+
+	return element;
+}
+
+QString SketchCache::cacheFilename(const QString & sourcePath) {
+	QByteArray pathHash = QCryptographicHash::hash(QFileInfo(sourcePath).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1);
+	return FolderUtils::getUserDataStorePath("sketchcache") + "/" + QString(pathHash.toHex()) + CacheExtension;
+}
+
+QByteArray SketchCache::hash(const QByteArray & fzContents) {
+	return QCryptographicHash::hash(fzContents, QCryptographicHash::Sha1);
+}
+
+bool SketchCache::readHeader(QDataStream & stream, qint64 & size, qint64 & modified, QByteArray & fzHash)
+{
+	quint32 magic, version;
+	stream >> magic >> version;
+	if (magic != CacheMagic || version != CacheVersion) return false;
+
+	stream >> size >> modified >> fzHash;
+	return stream.status() == QDataStream::Ok;
+}
+
+bool SketchCache::read(const QString & sourcePath, QDomDocument & shell, QList<QDomElement> & instanceList, QByteArray & fzHash) 
+{
+	QFileInfo sourceInfo(sourcePath);
+	if (!sourceInfo.exists()) return false;
+
+	QFile file(cacheFilename(sourcePath));
+	if (!file.exists()) return false;
+	if (!file.open(QFile::ReadOnly)) return false;
+
+	// map rather than read: when the sketch has changed only the header is ever touched
+	uchar * data = file.map(0, file.size());
+	if (data == NULL) return false;
+
+	QByteArray bytes = QByteArray::fromRawData((const char *) data, (int) file.size());
+	QDataStream stream(bytes);
+	stream.setVersion(QDataStream::Qt_4_6);
+
+	qint64 size, modified;
+	bool result = false;
+	if (readHeader(stream, size, modified, fzHash) && size == sourceInfo.size() && modified == sourceInfo.lastModified().toMSecsSinceEpoch()) {
+		// all nodes go into one document, as with a parse, so instances don't each carry a document of their own
+		QDomDocument document;
+		QDomNode root = readNode(stream, document);
+		if (!root.isNull()) {
+			document.appendChild(root);
+		}
+
+		quint32 count = 0;
+		stream >> count;
+		QList<QDomElement> instances;
+		for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+			QDomNode instance = readNode(stream, document);
+			if (instance.isNull()) break;
+
+			instances.append(instance.toElement());
+		}
+
+		if (stream.status() == QDataStream::Ok && !root.isNull() && (quint32) instances.count() == count) {
+			shell = document;
+			instanceList = instances;
+			result = true;
+		}
+		else {
+			DebugDialog::debug(QString("sketch cache %1 is corrupt").arg(file.fileName()));
+		}
+	}
+
+	file.unmap(data);
+	return result;
+}
+
+bool SketchCache::write(const QString & sourcePath, const QByteArray & fzHash, QDomDocument & shell, const QList<QDomElement> & instanceList) 
+{
+	QFileInfo sourceInfo(sourcePath);
+	if (!sourceInfo.exists()) return false;
+
+	QDir().mkpath(FolderUtils::getUserDataStorePath("sketchcache"));
+	prune();
+
+	QFile file(cacheFilename(sourcePath));
+	if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+		DebugDialog::debug(QString("unable to write sketch cache %1").arg(file.fileName()));
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_4_6);
+	stream << CacheMagic << CacheVersion << (qint64) sourceInfo.size() << (qint64) sourceInfo.lastModified().toMSecsSinceEpoch() << fzHash;
+	writeNode(stream, shell.documentElement());
+	stream << (quint32) instanceList.count();
+	foreach (QDomElement instance, instanceList) {
+		writeNode(stream, instance);
+	}
+
+	return stream.status() == QDataStream::Ok;
+}
+
+void SketchCache::verify(const QString & sourcePath, const QString & fzPath, const QByteArray & fzContents, const QByteArray & fzHash)
+{
+	// size and modification time can match a sketch that has since changed (a copy, a restored backup),
+	// so the .fz is hashed after the fact and a stale entry dropped; it is only ever used that once
+	QtConcurrent::run(verifyAux, sourcePath, fzPath, fzContents, fzHash);
+}
+
+void SketchCache::verifyAux(const QString & sourcePath, const QString & fzPath, const QByteArray & fzContents, const QByteArray & fzHash)
+{
+	QByteArray contents = fzContents;
+	if (contents.isEmpty()) {
+		QFile fz(fzPath);
+		if (!fz.open(QFile::ReadOnly)) return;
+
+		contents = fz.readAll();
+	}
+
+	if (hash(contents) == fzHash) return;
+
+	// the entry may have been rewritten by a save since it was read; only remove the one that was checked
+	QFile file(cacheFilename(sourcePath));
+	if (!file.open(QFile::ReadOnly)) return;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_4_6);
+	qint64 size, modified;
+	QByteArray cachedHash;
+	bool stale = readHeader(stream, size, modified, cachedHash) && cachedHash == fzHash;
+	file.close();
+	if (stale) {
+		file.remove();
+	}
+}
+
+void SketchCache::prune() 
+{
+	// one entry per sketch file, rewritten on each save; keep only the most recently saved
+	QDir dir(FolderUtils::getUserDataStorePath("sketchcache"));
+	QFileInfoList entries = dir.entryInfoList(QStringList("*" + CacheExtension), QDir::Files, QDir::Time);
+	for (int i = MaxCacheEntries - 1; i < entries.count(); i++) {
+		QFile::remove(entries.at(i).absoluteFilePath());
+	}
+}
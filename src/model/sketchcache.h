@@ -0,0 +1,63 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef SKETCHCACHE_H
+#define SKETCHCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QDomDocument>
+#include <QDomElement>
+#include <QDataStream>
+
+// Binary copy of an .fz file's module header and instance elements, so reopening the sketch
+// rebuilds them without parsing xml. The cache stops at the dom: parts, items and connections are still
+// built from these elements by the model and the sketch widgets, exactly as after a parse.
+// Entries live in the per-user sketchcache folder, one per sketch file (the .fzz the user opened),
+// and are matched on that file's size and modification time; the hash of the .fz bytes stored
+// with them is only checked after the sketch has loaded, off the gui thread.
+
+class SketchCache
+{
+public:
+	static QString cacheFilename(const QString & sourcePath);
+	static QByteArray hash(const QByteArray & fzContents);
+	static bool read(const QString & sourcePath, QDomDocument & shell, QList<QDomElement> & instanceList, QByteArray & fzHash);
+	static bool write(const QString & sourcePath, const QByteArray & fzHash, QDomDocument & shell, const QList<QDomElement> & instanceList);
+	static void verify(const QString & sourcePath, const QString & fzPath, const QByteArray & fzContents, const QByteArray & fzHash);
+
+protected:
+	static void prune();
+	static void verifyAux(const QString & sourcePath, const QString & fzPath, const QByteArray & fzContents, const QByteArray & fzHash);
+	static bool readHeader(QDataStream &, qint64 & size, qint64 & modified, QByteArray & fzHash);
+
+public:
+	static const QString CacheExtension;
+};
+
+#endif
@@ -34,12 +34,14 @@ static const QColor HoverColor(0x00, 0x00, 0x00);
 static const QColor PressedColor(84, 24, 44 /*0xff, 0xff, 0xff */);
 static const int FontPixelSize = 11;
 static const QString FontFamily = "Droid Sans";
+static const int MaxDirtyRects = 16;			// past this many, re-render their union instead
 
 MiniView::MiniView(QWidget *parent )
 	: QFrame(parent)
 {
 	m_graphicsView = NULL;
 	m_selected = false;
+	m_cacheDirty = true;
 	m_updateSceneTimer.setSingleShot(true);
 	m_updateSceneTimer.setInterval(250);
 	connect(&m_updateSceneTimer, SIGNAL(timeout()), this, SLOT(reallyUpdateScene()));
@@ -80,9 +82,20 @@ void MiniView::paintEvent(QPaintEvent * event) {
 		m_sceneRect.setRect((width() - cw) / 2, (height() - ch) / 2, cw, ch);
 		//DebugDialog::debug(QString("m_sceneRect:%1 %2 %3 %4").arg(m_sceneRect.left()).arg(m_sceneRect.top()).arg(m_sceneRect.width()).arg(m_sceneRect.height()));
 
-		scene->setDisplayHandles(false);
-		scene->render(&painter, m_sceneRect, sr, Qt::KeepAspectRatio);
-		scene->setDisplayHandles(true);
+		if (cw > 0 && ch > 0) {
+			if (m_cacheDirty || m_cache.size() != QSize(cw, ch) || m_cacheSourceRect != sr) {
+				m_cache = QImage(cw, ch, QImage::Format_ARGB32_Premultiplied);
+				m_cacheSourceRect = sr;
+				renderCache(scene, sr, QList<QRectF>() << sr);
+			}
+			else if (m_dirtyRects.count() > 0) {
+				renderCache(scene, sr, m_dirtyRects);
+			}
+			m_cacheDirty = false;
+			m_dirtyRects.clear();
+
+			painter.drawImage(m_sceneRect.topLeft(), m_cache);
+		}
 	}
 
 	QPen pen(m_titleColor, 1);
@@ -107,23 +120,69 @@ void MiniView::setView(QGraphicsView * view) {
 	if (m_graphicsView) {
 		if (m_graphicsView->scene()) {
 			disconnect(m_graphicsView->scene(), SIGNAL(void sceneRectChanged(QRectF)), this, SLOT(void updateSceneRect()));
-			disconnect(m_graphicsView->scene(), SIGNAL(changed(QList<QRectF>)), this, SLOT(updateScene()));
+			disconnect(m_graphicsView->scene(), SIGNAL(changed(QList<QRectF>)), this, SLOT(updateScene(const QList<QRectF> &)));
 
 		}
 	}
 	m_graphicsView = view;
 	if (view->scene()) {
 		connect(view->scene(), SIGNAL(sceneRectChanged(QRectF)), this, SLOT(updateSceneRect()));
-		connect(view->scene(), SIGNAL(changed(QList<QRectF>)), this, SLOT(updateScene()));
+		connect(view->scene(), SIGNAL(changed(QList<QRectF>)), this, SLOT(updateScene(const QList<QRectF> &)));
 	}
+	m_cacheDirty = true;
 }
 
 void MiniView::updateScene() 
 {
+	m_cacheDirty = true;
+	m_updateSceneTimer.stop();
+	m_updateSceneTimer.start();
+}
+
+void MiniView::updateScene(const QList<QRectF> & region) 
+{
+	m_dirtyRects.append(region);
+	if (m_dirtyRects.count() > MaxDirtyRects) {
+		QRectF r;
+		foreach (QRectF dirtyRect, m_dirtyRects) {
+			r |= dirtyRect;
+		}
+		m_dirtyRects.clear();
+		m_dirtyRects.append(r);
+	}
 	m_updateSceneTimer.stop();
 	m_updateSceneTimer.start();
 }
 
+void MiniView::renderCache(FGraphicsScene * scene, const QRectF & sourceRect, const QList<QRectF> & dirtyRects)
+{
+	double sx = m_cache.width() / sourceRect.width();
+	double sy = m_cache.height() / sourceRect.height();
+
+	QPainter cachePainter(&m_cache);
+	scene->setDisplayHandles(false);
+	scene->setLowDetail(true);
+	foreach (QRectF dirtyRect, dirtyRects) {
+		QRectF source = dirtyRect.intersected(sourceRect);
+		if (source.isEmpty()) continue;
+
+		// snap to whole cache pixels, plus one for antialiasing, and map back so the source matches exactly
+		QRect target = QRectF((source.left() - sourceRect.left()) * sx, (source.top() - sourceRect.top()) * sy, source.width() * sx, source.height() * sy).toAlignedRect();
+		target.adjust(-1, -1, 1, 1);
+		target &= m_cache.rect();
+		if (target.isEmpty()) continue;
+
+		source.setRect(sourceRect.left() + target.left() / sx, sourceRect.top() + target.top() / sy, target.width() / sx, target.height() / sy);
+		cachePainter.save();
+		cachePainter.setClipRect(target);
+		cachePainter.fillRect(target, scene->backgroundBrush());
+		scene->render(&cachePainter, target, source, Qt::IgnoreAspectRatio);
+		cachePainter.restore();
+	}
+	scene->setLowDetail(false);
+	scene->setDisplayHandles(true);
+}
+
 void MiniView::updateSceneRect() 
 {
 	updateScene();
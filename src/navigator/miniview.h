@@ -34,6 +34,7 @@ $Date: 2012-01-03 07:53:58 -0800 (Tue, 03 Jan 2012) $
 #include <QGraphicsView>
 #include <QTimer>
 #include <QPixmap>
+#include <QImage>
 
 class MiniView : public QFrame
 {
@@ -52,10 +53,12 @@ protected:
 	void resizeEvent ( QResizeEvent * event ); 
 	void mousePressEvent(QMouseEvent *event);
     void paintEvent(QPaintEvent *);
+	void renderCache(class FGraphicsScene *, const QRectF & sourceRect, const QList<QRectF> & dirtyRects);
 
 public slots:
 	void updateSceneRect();
 	void updateScene();
+	void updateScene(const QList<QRectF> &);
 	void reallyUpdateScene();
 	void navigatorMousePressedSlot(class MiniViewContainer *);
 	void navigatorMouseEnterSlot(class MiniViewContainer *);
@@ -74,6 +77,10 @@ protected:
 	int m_lastHeight;
 	QTimer m_updateSceneTimer;
 	QRectF m_sceneRect;
+	QImage m_cache;
+	QRectF m_cacheSourceRect;
+	QList<QRectF> m_dirtyRects;
+	bool m_cacheDirty;
 };
 
 #endif
@@ -103,6 +103,9 @@ QString BinManager::CurrentBinStyle = "background-color: black;";
 
 QHash<QString, QString> BinManager::StandardBinIcons;
 
+static const int PrefetchDelay = 3000;			// ms after startup before placeholder bins start loading in the background
+static const int PrefetchInterval = 250;		// ms between prefetched bins, so the ui keeps up in between
+
 BinManager::BinManager(class ReferenceModel *refModel, class HtmlInfoView *infoView, WaitPushUndoStack *undoStack, MainWindow* parent)
 	: QFrame(parent)
 {
@@ -138,8 +141,9 @@ BinManager::BinManager(class ReferenceModel *refModel, class HtmlInfoView *infoV
 	findAllBins(actualLocations);
 	restoreStateAndGeometry(actualLocations);
 	foreach (BinLocation * location, actualLocations) {
+		// restored bins are placeholders: the .fzb is only read when the tab is activated or searched
 		PartsBinPaletteWidget* bin = newBin();
-        bin->load(location->path, m_mainWindow->fileProgressDialog(), true);
+		bin->loadPlaceholder(location->path, location->title, location->icon);
 		m_stackTabWidget->addTab(bin, bin->icon(), bin->title());
 		m_stackTabWidget->stackTabBar()->setTabToolTip(m_stackTabWidget->count() - 1, bin->title());
 		registerBin(bin);
@@ -151,6 +155,13 @@ BinManager::BinManager(class ReferenceModel *refModel, class HtmlInfoView *infoV
 	DebugDialog::debug("after core bin");
 
 	connectTabWidget();
+
+	m_prefetchTimer.setSingleShot(true);
+	connect(&m_prefetchTimer, SIGNAL(timeout()), this, SLOT(prefetchBin()));
+	QSettings settings;
+	if (settings.value("prefetchBins", false).toBool()) {
+		m_prefetchTimer.start(PrefetchDelay);
+	}
 }
 
 BinManager::~BinManager() {
@@ -627,6 +638,7 @@ void BinManager::restoreStateAndGeometry(QList<BinLocation *> & actualLocations)
 		if (!tLocation->path.isEmpty()) {
 			QFileInfo info(tLocation->path);
 			if (info.exists()) {
+				getBinTitle(tLocation->path, tLocation->title, tLocation->icon);
 				actualLocations.append(tLocation);
                                 tLocation->marked = true;
 			}		
@@ -672,8 +684,7 @@ void BinManager::findAllBins(QList<BinLocation *> & locations)
 	BinLocation * location = new BinLocation;
 	location->location = BinLocation::App;
 	location->path = CorePartsBinLocation;
-	QString icon;
-	getBinTitle(location->path, location->title, icon);
+	getBinTitle(location->path, location->title, location->icon);
 	locations.append(location);
 
 	QDir userBinsDir(FolderUtils::getUserDataStorePath("bins"));
@@ -693,8 +704,7 @@ void BinManager::findBins(QDir & dir, QList<BinLocation *> & locations, BinLocat
 		BinLocation * location = new BinLocation;
 		location->path = info.absoluteFilePath();
 		location->location = loc;
-		QString icon;
-		getBinTitle(location->path, location->title, icon);
+		getBinTitle(location->path, location->title, location->icon);
 		locations.append(location);
 	}
 }
@@ -731,6 +741,9 @@ void BinManager::tabCloseRequested(int index) {
 
 void BinManager::addPartTo(PartsBinPaletteWidget* bin, ModelPart* mp) {
 	if(mp) {
+		if (bin->fastLoaded()) {
+			bin->load(bin->fileName(), bin, false);
+		}
 		bool alreadyIn = bin->contains(mp->moduleID());
 		bin->addPart(mp);
 		if(!alreadyIn) {
@@ -798,6 +811,19 @@ QList<QAction*> BinManager::openedBinsActions(const QString &moduleId) {
 	return titlesAndActions.values();
 }
 
+void BinManager::prefetchBin() {
+	// load one placeholder bin per tick; bins build widgets, so this stays on the gui thread
+	for (int i = 0; i < m_stackTabWidget->count(); i++) {
+		PartsBinPaletteWidget * bin = getBin(i);
+		if (bin == NULL || !bin->fastLoaded()) continue;
+
+		DebugDialog::debug("prefetching bin " + bin->fileName());
+		bin->load(bin->fileName(), NULL, false);
+		m_prefetchTimer.start(PrefetchInterval);
+		return;
+	}
+}
+
 void BinManager::openBin(const QString &filename) {
 	openBinIn(filename, false);
 }
@@ -33,6 +33,7 @@ $Date: 2012-01-29 13:24:16 -0800 (Sun, 29 Jan 2012) $
 #include <QMenu>
 #include <QLabel>
 #include <QDir>
+#include <QTimer>
 
 class ModelPart;
 class PaletteModel;
@@ -50,6 +51,7 @@ struct BinLocation {
 
 	QString path;
 	QString title;
+	QString icon;
 	Location location;
 	bool marked;
 
@@ -143,6 +145,7 @@ class BinManager : public QFrame {
 		void exportSelected();
 		bool removeSelected();
 		void saveBundledBin();
+		void prefetchBin();
 
 	protected:
 		void createMenu();
@@ -180,6 +183,7 @@ protected:
 		QHash<QString /*filename*/,PartsBinPaletteWidget*> m_openedBins;
 		int m_unsavedBinsCount;
 		QString m_defaultSaveFolder;
+		QTimer m_prefetchTimer;
 
 		QMenu *m_binContextMenu;
 		QMenu *m_combinedMenu;		
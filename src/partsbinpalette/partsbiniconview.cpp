@@ -38,9 +38,13 @@ $Date: 2012-01-03 07:53:58 -0800 (Tue, 03 Jan 2012) $
 #include "../model/palettemodel.h"
 #include "../items/partfactory.h"
 #include "partsbinpalettewidget.h"
+#include "../fsvgrenderer.h"
+#include "../layerattributes.h"
 
 #define ICON_SPACING 2
 
+static const int IconBatch = 24;			// icons rendered per timer tick so scrolling stays responsive
+
 PartsBinIconView::PartsBinIconView(ReferenceModel* refModel, PartsBinPaletteWidget *parent)
     : InfoGraphicsView((QWidget*)parent), PartsBinView(refModel, parent)
 {
@@ -62,6 +66,10 @@ PartsBinIconView::PartsBinIconView(ReferenceModel* refModel, PartsBinPaletteWidg
     m_noSelectionChangeEmition = false;
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
+	m_iconTimer.setSingleShot(true);
+	m_iconTimer.setInterval(0);
+	connect(&m_iconTimer, SIGNAL(timeout()), this, SLOT(loadVisibleIcons()));
+
     setContextMenuPolicy(Qt::CustomContextMenu);
     connect(
     	this, SIGNAL(customContextMenuRequested(const QPoint&)),
@@ -93,6 +101,7 @@ void PartsBinIconView::updateSize() {
 
 void PartsBinIconView::updateSizeAux(int width) {
 	setSceneRect(0, 0, width, m_layout->heightForWidth(width));
+	m_iconTimer.start();
 }
 
 void PartsBinIconView::resizeEvent(QResizeEvent * event) {
@@ -100,6 +109,101 @@ void PartsBinIconView::resizeEvent(QResizeEvent * event) {
 	updateSize(event->size());
 }
 
+void PartsBinIconView::showEvent(QShowEvent * event) {
+	InfoGraphicsView::showEvent(event);
+	m_iconTimer.start();
+}
+
+void PartsBinIconView::scrollContentsBy(int dx, int dy) {
+	InfoGraphicsView::scrollContentsBy(dx, dy);
+	m_iconTimer.start();
+}
+
+void PartsBinIconView::loadVisibleIcons() {
+	// only icons within a viewport's height of the visible area get a part and a rendered icon;
+	// icons that have scrolled well out of range give their pixmaps back
+	if (!isVisible()) return;
+
+	QRectF visible = mapToScene(viewport()->rect()).boundingRect();
+	double margin = visible.height();
+	QRectF keep = visible.adjusted(0, -margin, 0, margin);
+	QRectF release = visible.adjusted(0, -3 * margin, 0, 3 * margin);
+
+	QList<SvgIconWidget *> toLoad;
+	bool more = false;
+	for (int i = 0; i < m_layout->count(); i++) {
+		SvgIconWidget * icon = dynamic_cast<SvgIconWidget *>(m_layout->itemAt(i));
+		if (icon == NULL) continue;
+
+		QRectF r = icon->geometry();
+		if (r.intersects(keep)) {
+			if (icon->iconLoaded()) continue;
+
+			if (toLoad.count() >= IconBatch) {
+				more = true;
+				continue;
+			}
+
+			toLoad.append(icon);
+		}
+		else if (!r.intersects(release)) {
+			icon->unloadIcon();
+		}
+	}
+
+	// read the batch's svg files on the thread pool; parsing and rendering stay here,
+	// since the renderer cache and QPixmap may only be used from the gui thread
+	QStringList filenames;
+	foreach (SvgIconWidget * icon, toLoad) {
+		ensureItemBase(icon);
+		ModelPart * modelPart = icon->modelPart();
+		if (modelPart == NULL || modelPart->domDocument() == NULL) continue;
+
+		QDomElement layers = LayerAttributes::getSvgElementLayers(modelPart->domDocument(), ViewIdentifierClass::IconView);
+		QString image = layers.attribute("image");
+		if (image.isEmpty()) continue;
+
+		QString filename = ItemBase::getSvgFilename(modelPart, image);
+		if (!filename.isEmpty()) {
+			filenames.append(filename);
+		}
+	}
+	FSvgRenderer::prefetch(filenames);
+
+	foreach (SvgIconWidget * icon, toLoad) {
+		icon->loadIcon();
+	}
+	FSvgRenderer::clearPrefetched(filenames);
+
+	if (more) {
+		// come back for the rest after pending events
+		m_iconTimer.start();
+	}
+}
+
+void PartsBinIconView::ensureItemBase(SvgIconWidget * icon) {
+	// parts are only created for icons that come into view (or get clicked before their icon has loaded)
+	if (icon->itemBase() != NULL) return;
+
+	ModelPart * modelPart = icon->modelPart();
+	if (modelPart == NULL || modelPart->itemType() == ModelPart::Space) return;
+
+	ItemBase * itemBase = PartFactory::createPart(modelPart, ViewLayer::ThroughHoleThroughTop_OneLayer, ViewIdentifierClass::IconView, ViewGeometry(), ItemBase::getNextID(), NULL, NULL, false);
+	ItemBase::PluralType plural = itemBase->isPlural();
+	if (plural == ItemBase::NotSure) {
+		QHash<QString,QString> properties = modelPart->properties();
+		QString family = properties.value("family", "").toLower();
+		foreach (QString key, properties.keys()) {
+			QStringList values = m_refModel->values(family, key);
+			if (values.length() > 1) {
+				plural = ItemBase::Plural;
+				break;
+			}
+		}
+	}
+	icon->setItemBase(itemBase, plural == ItemBase::Plural);
+}
+
 void PartsBinIconView::mousePressEvent(QMouseEvent *event) {
 	SvgIconWidget* icon = svgIconWidgetAt(event->pos());
 	if (icon == NULL || event->button() != Qt::LeftButton) {
@@ -122,6 +226,7 @@ void PartsBinIconView::mousePressEvent(QMouseEvent *event) {
 			QString moduleID = icon->moduleID();
 			QPoint hotspot = (mts.toPoint()-icon->pos().toPoint());
 
+			ensureItemBase(icon);
 			viewItemInfo(icon->itemBase());
 
 			mousePressOnItem(event->pos(), moduleID, icon->rect().size().toSize(), (mts - icon->pos()), hotspot );
@@ -140,6 +245,7 @@ void PartsBinIconView::doClear() {
 	delete scene();				// deleting scene deletes QGraphicsItems
 	setScene(new QGraphicsScene(this));
 	setupLayout();
+	m_iconTimer.stop();
 }
 
 void PartsBinIconView::addPart(ModelPart * model, int position) {
@@ -205,27 +311,11 @@ int PartsBinIconView::setItemAux(ModelPart * modelPart, int position) {
 		return position;
 	}
 	
-	SvgIconWidget* svgicon = NULL;
+	// the part itself is created by ensureItemBase() once the icon comes into view
+	SvgIconWidget* svgicon = new SvgIconWidget(modelPart, ViewIdentifierClass::IconView, NULL, false);
 	if (modelPart->itemType() != ModelPart::Space) {
-		ItemBase * itemBase = PartFactory::createPart(modelPart, ViewLayer::ThroughHoleThroughTop_OneLayer, ViewIdentifierClass::IconView, ViewGeometry(), ItemBase::getNextID(), NULL, NULL, false);
-		ItemBase::PluralType plural = itemBase->isPlural();
-		if (plural == ItemBase::NotSure) {
-			QHash<QString,QString> properties = modelPart->properties();
-			QString family = properties.value("family", "").toLower();
-			foreach (QString key, properties.keys()) {
-				QStringList values = m_refModel->values(family, key);
-				if (values.length() > 1) {
-					plural = ItemBase::Plural;
-					break;
-				}
-			}
-		}
-		svgicon = new SvgIconWidget(modelPart, ViewIdentifierClass::IconView, itemBase, plural == ItemBase::Plural);
 		m_partHash[moduleID] = modelPart;
 	}
-	else {
-		svgicon = new SvgIconWidget(modelPart, ViewIdentifierClass::IconView, NULL, false);
-	}
 
 
 	if(position > -1) {
@@ -30,6 +30,7 @@ $Date: 2012-01-03 07:53:58 -0800 (Tue, 03 Jan 2012) $
 
 #include <QFrame>
 #include <QGraphicsView>
+#include <QTimer>
 
 #include "partsbinview.h"
 #include "../sketch/infographicsview.h"
@@ -69,6 +70,8 @@ class PartsBinIconView : public InfoGraphicsView, public PartsBinView
 		int setItemAux(ModelPart *, int position = -1);
 
 		void resizeEvent(QResizeEvent * event);
+		void showEvent(QShowEvent * event);
+		void scrollContentsBy(int dx, int dy);
 		void updateSize(QSize newSize);
 		void updateSize();
 		void updateSizeAux(int width);
@@ -78,6 +81,7 @@ class PartsBinIconView : public InfoGraphicsView, public PartsBinView
 		QGraphicsWidget* closestItemTo(const QPoint& pos);
 		class SvgIconWidget * svgIconWidgetAt(const QPoint & pos);
 		class SvgIconWidget * svgIconWidgetAt(int x, int y);
+		void ensureItemBase(class SvgIconWidget *);
 
 	public slots:
 		void setSelected(int position, bool doEmit=false);
@@ -86,6 +90,7 @@ class PartsBinIconView : public InfoGraphicsView, public PartsBinView
 
 	protected slots:
 		void showContextMenu(const QPoint& pos);
+		void loadVisibleIcons();
 
 	signals:
 		void informItemMoved(int fromIndex, int toIndex);
@@ -100,6 +105,7 @@ class PartsBinIconView : public InfoGraphicsView, public PartsBinView
 
 		QMenu *m_itemMenu;
 		bool m_noSelectionChangeEmition;
+		QTimer m_iconTimer;
 };
 
 #endif /* ICONVIEW_H_ */
@@ -41,6 +41,10 @@ $Date: 2012-01-25 22:31:21 -0800 (Wed, 25 Jan 2012) $
 static const QColor SectionHeaderBackgroundColor(128, 128, 128);
 static const QColor SectionHeaderForegroundColor(32, 32, 32);
 
+static const int IconBatch = 24;			// icons rendered per timer tick so scrolling stays responsive
+static const int IconLoadedRole = Qt::UserRole + 2;
+static QPixmap * BlankIcon = NULL;
+
 PartsBinListView::PartsBinListView(ReferenceModel* refModel, PartsBinPaletteWidget *parent)
 	: QListWidget((QWidget *) parent), PartsBinView(refModel, parent)
 {
@@ -58,6 +62,16 @@ PartsBinListView::PartsBinListView(ReferenceModel* refModel, PartsBinPaletteWidg
 	setDragDropMode(QAbstractItemView::DragDrop);
 	setAcceptDrops(true);
 
+	m_iconTimer.setSingleShot(true);
+	m_iconTimer.setInterval(0);
+	connect(&m_iconTimer, SIGNAL(timeout()), this, SLOT(loadVisibleIcons()));
+
+	if (BlankIcon == NULL) {
+		// rows get a transparent placeholder so they keep their height until the real icon is loaded
+		BlankIcon = new QPixmap(HtmlInfoView::STANDARD_ICON_IMG_WIDTH, HtmlInfoView::STANDARD_ICON_IMG_HEIGHT);
+		BlankIcon->fill(Qt::transparent);
+	}
+
     setContextMenuPolicy(Qt::CustomContextMenu);
     connect(
     	this, SIGNAL(customContextMenuRequested(const QPoint&)),
@@ -74,6 +88,7 @@ PartsBinListView::~PartsBinListView() {
 
 void PartsBinListView::doClear() {
 	m_hoverItem = NULL;
+	m_iconTimer.stop();
 	PartsBinView::doClear();
 	clear();
 }
@@ -103,19 +118,9 @@ int PartsBinListView::setItemAux(ModelPart * modelPart, int position) {
 	else {
 		ItemBase * itemBase = PartFactory::createPart(modelPart, ViewLayer::ThroughHoleThroughTop_OneLayer, ViewIdentifierClass::IconView, ViewGeometry(), ItemBase::getNextID(), NULL, NULL, false);
 		lwi->setData(Qt::UserRole, qVariantFromValue( itemBase ) );
-		QString error;
-		LayerAttributes layerAttributes;
-		FSvgRenderer * renderer = ItemBase::setUpImage(modelPart, ViewIdentifierClass::IconView, ViewLayer::Icon, itemBase->viewLayerSpec(), layerAttributes, error);
-		if (renderer != NULL) {
-			if (itemBase) {
-				itemBase->setFilename(renderer->filename());
-			}
-			QSize size(HtmlInfoView::STANDARD_ICON_IMG_WIDTH, HtmlInfoView::STANDARD_ICON_IMG_HEIGHT);
-			QPixmap * pixmap = FSvgRenderer::getPixmap(modelPart->moduleID(), ViewLayer::Icon, size);
-			lwi->setIcon(QIcon(*pixmap));
-			delete pixmap;
-			lwi->setData(Qt::UserRole + 1, renderer->defaultSize());
-		}
+		lwi->setData(IconLoadedRole, false);
+		lwi->setIcon(QIcon(*BlankIcon));
+		// the renderer and icon are set up by loadVisibleIcons() once the row scrolls near the viewport
 
 		m_partHash[moduleID] = modelPart;
 	}
@@ -127,10 +132,76 @@ int PartsBinListView::setItemAux(ModelPart * modelPart, int position) {
 		position = this->count();
 	}
 
+	m_iconTimer.start();
 	return position;
 	
 }
 
+void PartsBinListView::loadIcon(QListWidgetItem * lwi) {
+	lwi->setData(IconLoadedRole, true);
+
+	ItemBase * itemBase = lwi->data(Qt::UserRole).value<ItemBase *>();
+	if (itemBase == NULL) return;
+
+	ModelPart * modelPart = itemBase->modelPart();
+	if (modelPart == NULL) return;
+
+	QString error;
+	LayerAttributes layerAttributes;
+	FSvgRenderer * renderer = ItemBase::setUpImage(modelPart, ViewIdentifierClass::IconView, ViewLayer::Icon, itemBase->viewLayerSpec(), layerAttributes, error);
+	if (renderer == NULL) return;
+
+	itemBase->setFilename(renderer->filename());
+	QSize size(HtmlInfoView::STANDARD_ICON_IMG_WIDTH, HtmlInfoView::STANDARD_ICON_IMG_HEIGHT);
+	QPixmap * pixmap = FSvgRenderer::getPixmap(modelPart->moduleID(), ViewLayer::Icon, size);
+	if (pixmap) {
+		lwi->setIcon(QIcon(*pixmap));
+		delete pixmap;
+	}
+	lwi->setData(Qt::UserRole + 1, renderer->defaultSize());
+}
+
+void PartsBinListView::loadVisibleIcons() {
+	// only rows within a viewport's height of the visible area get their icons rendered
+	if (!isVisible()) return;
+
+	QRect visible = viewport()->rect();
+	int margin = visible.height();
+	QRect keep = visible.adjusted(0, -margin, 0, margin);
+
+	int loaded = 0;
+	for (int i = 0; i < count(); i++) {
+		QListWidgetItem * lwi = item(i);
+		if (lwi->data(IconLoadedRole).toBool()) continue;
+		if (lwi->data(Qt::UserRole).value<ItemBase *>() == NULL) continue;
+		if (!visualItemRect(lwi).intersects(keep)) continue;
+
+		if (loaded >= IconBatch) {
+			// come back for the rest after pending events
+			m_iconTimer.start();
+			return;
+		}
+
+		loadIcon(lwi);
+		loaded++;
+	}
+}
+
+void PartsBinListView::resizeEvent(QResizeEvent * event) {
+	QListWidget::resizeEvent(event);
+	m_iconTimer.start();
+}
+
+void PartsBinListView::showEvent(QShowEvent * event) {
+	QListWidget::showEvent(event);
+	m_iconTimer.start();
+}
+
+void PartsBinListView::scrollContentsBy(int dx, int dy) {
+	QListWidget::scrollContentsBy(dx, dy);
+	m_iconTimer.start();
+}
+
 void PartsBinListView::mouseMoveEvent(QMouseEvent *event) {
 	if (m_infoView == NULL) return;
 
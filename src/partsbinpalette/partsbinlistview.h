@@ -30,6 +30,7 @@ $Date: 2011-11-16 07:16:04 -0800 (Wed, 16 Nov 2011) $
 
 #include <QListWidget>
 #include <QMouseEvent>
+#include <QTimer>
 
 #include "partsbinview.h"
 
@@ -55,6 +56,7 @@ class PartsBinListView : public QListWidget, public PartsBinView {
 
 	protected slots:
 		void showContextMenu(const QPoint& pos);
+		void loadVisibleIcons();
 
 	signals:
 		void informItemMoved(int fromIndex, int toIndex);
@@ -77,6 +79,10 @@ class PartsBinListView : public QListWidget, public PartsBinView {
 		const QString& itemModuleID(const QListWidgetItem *item);
 
 		void showInfo(QListWidgetItem * item);
+		void loadIcon(QListWidgetItem * item);
+		void resizeEvent(QResizeEvent * event);
+		void showEvent(QShowEvent * event);
+		void scrollContentsBy(int dx, int dy);
 
 		bool dropMimeData(int index, const QMimeData *data, Qt::DropAction action);
 		QMimeData * mimeData(const QList<QListWidgetItem *> items) const;
@@ -85,6 +91,7 @@ class PartsBinListView : public QListWidget, public PartsBinView {
 	protected:
 		class HtmlInfoView * m_infoView;
 		QListWidgetItem * m_hoverItem;
+		QTimer m_iconTimer;
 
 };
 #endif /* LISTVIEW_H_ */
@@ -442,9 +442,7 @@ void PartsBinPaletteWidget::load(const QString &filename, QWidget * progressTarg
 	if (fastLoad) {
 		QString binName, iconName;
 		if (BinManager::getBinTitle(filename, binName, iconName)) {
-			m_fileName = filename;
-			grabTitle(binName, iconName);
-			m_fastLoaded = true;
+			loadPlaceholder(filename, binName, iconName);
 		}
 		return;
 	}
@@ -471,7 +469,7 @@ void PartsBinPaletteWidget::load(const QString &filename, QWidget * progressTarg
 	}
 	
 	if (progressTarget) {
-		connect(paletteBinModel, SIGNAL(loadingInstances(ModelBase *, QDomElement &)), progressTarget, SLOT(loadingInstancesSlot(ModelBase *, QDomElement &)));
+		connect(paletteBinModel, SIGNAL(loadingInstances(ModelBase *, int)), progressTarget, SLOT(loadingInstancesSlot(ModelBase *, int)));
 		connect(paletteBinModel, SIGNAL(loadingInstance(ModelBase *, QDomElement &)), progressTarget, SLOT(loadingInstanceSlot(ModelBase *, QDomElement &)));
 		connect(m_iconView, SIGNAL(settingItem()), progressTarget, SLOT(settingItemSlot()));
 		connect(m_listView, SIGNAL(settingItem()), progressTarget, SLOT(settingItemSlot()));
@@ -494,7 +492,7 @@ void PartsBinPaletteWidget::load(const QString &filename, QWidget * progressTarg
 
 	if (progressTarget) {
         DebugDialog::debug("close progress " + filename);
-		disconnect(paletteBinModel, SIGNAL(loadingInstances(ModelBase *, QDomElement &)), progressTarget, SLOT(loadingInstancesSlot(ModelBase *, QDomElement &)));
+		disconnect(paletteBinModel, SIGNAL(loadingInstances(ModelBase *, int)), progressTarget, SLOT(loadingInstancesSlot(ModelBase *, int)));
 		disconnect(paletteBinModel, SIGNAL(loadingInstance(ModelBase *, QDomElement &)), progressTarget, SLOT(loadingInstanceSlot(ModelBase *, QDomElement &)));
 		disconnect(m_iconView, SIGNAL(settingItem()), progressTarget, SLOT(settingItemSlot()));
 		disconnect(m_listView, SIGNAL(settingItem()), progressTarget, SLOT(settingItemSlot()));
@@ -509,6 +507,15 @@ void PartsBinPaletteWidget::load(const QString &filename, QWidget * progressTarg
 	//delete paletteReferenceModel;
 }
 
+void PartsBinPaletteWidget::loadPlaceholder(const QString & filename, const QString & title, const QString & iconName) {
+	// only the tab's title and icon; the bin file is read by load() the first time the bin is needed
+	m_location = BinLocation::findLocation(filename);
+	m_fileName = filename;
+	QString iconFilename = iconName;
+	grabTitle(title, iconFilename);
+	m_fastLoaded = true;
+}
+
 void PartsBinPaletteWidget::undoStackCleanChanged(bool isClean) {
 	if(!isClean && currentBinIsCore()) {
 		setFilename(QString::null);
@@ -70,6 +70,7 @@ class PartsBinPaletteWidget : public QFrame, public Bundler {
         void removePart(const QString& moduleID);
         void removeParts();
         void load(const QString& filename, QWidget * progressTarget, bool fastLoad);
+		void loadPlaceholder(const QString & filename, const QString & title, const QString & iconName);
 
 		bool contains(const QString &moduleID);
 		void setDirty(bool dirty=true);
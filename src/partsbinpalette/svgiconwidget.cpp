@@ -86,6 +86,11 @@ SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewIdentifierClass::ViewIde
 {
 	m_moduleId = modelPart->moduleID();
 	m_itemBase = itemBase;
+	m_modelPart = modelPart;
+	m_viewIdentifier = viewIdentifier;
+	m_plural = plural;
+	m_iconLoaded = false;
+	m_pixmapItem = NULL;
 
 
 	if (modelPart->itemType() == ModelPart::Space) {
@@ -107,29 +112,8 @@ SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewIdentifierClass::ViewIde
 		setAcceptHoverEvents(true);
 		setFlags(QGraphicsItem::ItemIsSelectable);
 
-		QString error;
-		LayerAttributes layerAttributes;
-		FSvgRenderer * renderer = ItemBase::setUpImage(modelPart, viewIdentifier, ViewLayer::Icon, ViewLayer::ThroughHoleThroughTop_OneLayer, layerAttributes, error);
-		if (renderer && m_itemBase) {
-			m_itemBase->setFilename(renderer->filename());
-		}
-
-		QPixmap pixmap(plural ? *PluralImage : *SingularImage);
-		QPixmap * icon = FSvgRenderer::getPixmap(m_moduleId, ViewLayer::Icon, QSize(ICON_SIZE, ICON_SIZE));
-		if (icon) {
-			QPainter painter;
-			painter.begin(&pixmap);
-			if (plural) {
-				painter.drawPixmap(PLURAL_OFFSET, PLURAL_OFFSET, *icon);
-			}
-			else {
-				painter.drawPixmap(SINGULAR_OFFSET, SINGULAR_OFFSET, *icon);
-			}
-			painter.end();
-			delete icon;
-		}
-
-		m_pixmapItem = new SvgIconPixmapItem(pixmap, this);
+		// start with the bare frame; the bin view calls loadIcon() once this widget scrolls near the viewport
+		m_pixmapItem = new SvgIconPixmapItem(plural ? *PluralImage : *SingularImage, this);
 		m_pixmapItem->setPlural(plural);
 
 		m_pixmapItem->setFlags(0);
@@ -142,6 +126,23 @@ SvgIconWidget::SvgIconWidget(ModelPart * modelPart, ViewIdentifierClass::ViewIde
 	}
 }
 
+void SvgIconWidget::setItemBase(ItemBase * itemBase, bool plural) {
+	// the bin view creates the part lazily, once this widget first comes near the viewport
+	if (m_itemBase != itemBase) delete m_itemBase;
+	m_itemBase = itemBase;
+	m_plural = plural;
+	if (m_pixmapItem) {
+		m_pixmapItem->setPlural(plural);
+		if (!m_iconLoaded) {
+			m_pixmapItem->setPixmap(plural ? *PluralImage : *SingularImage);
+		}
+	}
+	if (m_itemBase) {
+		m_itemBase->setTooltip();
+		setToolTip(m_itemBase->toolTip());
+	}
+}
+
 void SvgIconWidget::initNames() {
 	if (PluralImage == NULL) {
 		PluralImage = new QPixmap(":/resources/images/icons/parts_plural_v3_plur.png");
@@ -171,17 +172,60 @@ ItemBase *SvgIconWidget::itemBase() const {
 }
 
 ModelPart *SvgIconWidget::modelPart() const {
-	return m_itemBase->modelPart();
+	return m_modelPart;
 }
 
 const QString &SvgIconWidget::moduleID() const {
 	return m_moduleId;
 }
 
+bool SvgIconWidget::iconLoaded() const {
+	return m_iconLoaded || m_pixmapItem == NULL;
+}
+
+void SvgIconWidget::loadIcon() {
+	if (iconLoaded()) return;
+	if (m_modelPart == NULL) return;
+
+	m_iconLoaded = true;
+
+	QString error;
+	LayerAttributes layerAttributes;
+	FSvgRenderer * renderer = ItemBase::setUpImage(m_modelPart, m_viewIdentifier, ViewLayer::Icon, ViewLayer::ThroughHoleThroughTop_OneLayer, layerAttributes, error);
+	if (renderer && m_itemBase) {
+		m_itemBase->setFilename(renderer->filename());
+	}
+
+	QPixmap pixmap(m_plural ? *PluralImage : *SingularImage);
+	QPixmap * icon = FSvgRenderer::getPixmap(m_moduleId, ViewLayer::Icon, QSize(ICON_SIZE, ICON_SIZE));
+	if (icon) {
+		QPainter painter;
+		painter.begin(&pixmap);
+		if (m_plural) {
+			painter.drawPixmap(PLURAL_OFFSET, PLURAL_OFFSET, *icon);
+		}
+		else {
+			painter.drawPixmap(SINGULAR_OFFSET, SINGULAR_OFFSET, *icon);
+		}
+		painter.end();
+		delete icon;
+	}
+
+	m_pixmapItem->setPixmap(pixmap);
+}
+
+void SvgIconWidget::unloadIcon() {
+	if (m_pixmapItem == NULL || !m_iconLoaded) return;
+
+	// the frame images are shared, so this releases the composited pixmap
+	m_iconLoaded = false;
+	m_pixmapItem->setPixmap(m_plural ? *PluralImage : *SingularImage);
+}
+
 void SvgIconWidget::hoverEnterEvent ( QGraphicsSceneHoverEvent * event ){
 	QGraphicsWidget::hoverEnterEvent(event);
 	InfoGraphicsView * igv = InfoGraphicsView::getInfoGraphicsView(this);
-	if (igv) {
+	if (igv && m_itemBase) {
 		igv->hoverEnterItem(event, m_itemBase);
 	}
 }
@@ -189,7 +233,7 @@ void SvgIconWidget::hoverEnterEvent ( QGraphicsSceneHoverEvent * event ){
 void SvgIconWidget::hoverLeaveEvent ( QGraphicsSceneHoverEvent * event ) {
 	QGraphicsWidget::hoverLeaveEvent(event);
 	InfoGraphicsView * igv = InfoGraphicsView::getInfoGraphicsView(this);
-	if (igv) {
+	if (igv && m_itemBase) {
 		igv->hoverLeaveItem(event, m_itemBase);
 	}
 }
@@ -57,8 +57,12 @@ public:
 	SvgIconWidget(ModelPart *, ViewIdentifierClass::ViewIdentifier, ItemBase *, bool plural);
 	~SvgIconWidget();
 	ItemBase * itemBase() const;
+	void setItemBase(ItemBase *, bool plural);
 	ModelPart * modelPart() const;
 	const QString &moduleID() const;
+	bool iconLoaded() const;
+	void loadIcon();
+	void unloadIcon();
 
 	static void initNames();
 	static void cleanup();
@@ -73,6 +77,10 @@ protected:
 	QPointer<ItemBase> m_itemBase;
 	SvgIconPixmapItem * m_pixmapItem;
 	QString m_moduleId;
+	QPointer<ModelPart> m_modelPart;
+	ViewIdentifierClass::ViewIdentifier m_viewIdentifier;
+	bool m_plural;
+	bool m_iconLoaded;
 };
 
 
@@ -121,7 +121,7 @@ bool PartsEditorPaletteItem::createSvgPath(const QString &modelPartSharedPath, c
 		tempPath.second = "%2/" + layerFileName;
 
 		QStringList possibleRootFolders;
-		possibleRootFolders << FolderUtils::getApplicationSubFolderPath("parts") << FolderUtils::getUserDataStorePath("parts") << PartFactory::folderPath();
+		possibleRootFolders << FolderUtils::getApplicationSubFolderPath("parts") << FolderUtils::getUserDataStorePath("parts") << PartFactory::folderPath() << PartFactory::cacheFolderPath();
 		QStringList possibleFolders = ModelPart::possibleFolders();
 		foreach(QString rootFolder, possibleRootFolders) {
 			foreach(QString folder, possibleFolders) {
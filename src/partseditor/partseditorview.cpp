@@ -842,10 +842,12 @@ void PartsEditorView::copyToTempAndRenameIfNecessary(SvgAndPartFilePath *filePat
 	QString userSvgFolderPath = FolderUtils::getUserDataStorePath("parts")+"/svg";
 	QString coreSvgFolderPath = FolderUtils::getApplicationSubFolderPath("parts")+"/svg";
 	QString pfSvgFolderPath = PartFactory::folderPath()+"/svg"; 
+	QString pfCacheSvgFolderPath = PartFactory::cacheFolderPath()+"/svg"; 
 
 	if(!(filePathOrig->absolutePath().startsWith(userSvgFolderPath)
 		|| filePathOrig->absolutePath().startsWith(coreSvgFolderPath)
-		|| filePathOrig->absolutePath().startsWith(pfSvgFolderPath))
+		|| filePathOrig->absolutePath().startsWith(pfSvgFolderPath)
+		|| filePathOrig->absolutePath().startsWith(pfCacheSvgFolderPath))
 		) 
 	{ // it's outside the parts folder
 		DebugDialog::debug(QString("copying from %1").arg(m_originalSvgFilePath));
@@ -896,6 +898,7 @@ void PartsEditorView::setSvgFilePath(const QString &filePath) {
 	QString userSvgFolder = FolderUtils::getUserDataStorePath("parts")+"/svg";
 	QString coreSvgFolder = FolderUtils::getApplicationSubFolderPath("parts")+"/svg";
 	QString pfSvgFolder = PartFactory::folderPath()+"/svg";
+	QString pfCacheSvgFolder = PartFactory::cacheFolderPath()+"/svg";
 
 	QString tempFolder = m_tempFolder.absolutePath();
 
@@ -908,7 +911,7 @@ void PartsEditorView::setSvgFilePath(const QString &filePath) {
 	// but the file dialog returns a string beginning with "C:"
 	cs = Qt::CaseInsensitive;
 #endif
-	if(filePath.contains(userSvgFolder, cs) || filePath.contains(coreSvgFolder, cs) || filePath.contains(pfSvgFolder, cs)) {
+	if(filePath.contains(userSvgFolder, cs) || filePath.contains(coreSvgFolder, cs) || filePath.contains(pfSvgFolder, cs) || filePath.contains(pfCacheSvgFolder, cs)) {
 		int ix = filePath.indexOf("svg");
 		// is core/user file
 		relative = filePathAux.remove(0, ix + 4);
@@ -0,0 +1,204 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#include "propertyindex.h"
+
+static void setSlot(QBitArray & bits, int slot, bool value) {
+	if (slot >= bits.size()) bits.resize(slot + 1);
+	bits.setBit(slot, value);
+}
+
+static inline bool testSlot(const QBitArray & bits, int slot) {
+	return slot < bits.size() && bits.testBit(slot);
+}
+
+///////////////////////////////////////////////////////////
+
+PropertyIndex::PropertyIndex() {
+}
+
+void PropertyIndex::clear() {
+	m_families.clear();
+	m_slots.clear();
+	m_moduleIDs.clear();
+	m_slotFamilies.clear();
+	m_slotProperties.clear();
+	m_core.clear();
+}
+
+void PropertyIndex::addPart(const Part * part) {
+	if (part == NULL) return;
+
+	removePart(part->moduleID());
+
+	int slot = m_moduleIDs.count();
+	m_moduleIDs.append(part->moduleID());
+	m_slots.insert(part->moduleID(), slot);
+	m_slotFamilies.append(part->family());
+	setSlot(m_core, slot, part->isCore() == "1");
+
+	Family & family = m_families[part->family()];
+	setSlot(family.parts, slot, true);
+
+	QList< QPair<QString, QString> > slotProperties;
+	foreach (PartProperty * prop, part->properties()) {
+		setSlot(family.facets[prop->name()][prop->value()], slot, true);
+		slotProperties.append(QPair<QString, QString>(prop->name(), prop->value()));
+	}
+	if (!slotProperties.isEmpty()) {
+		setSlot(family.withProperties, slot, true);
+	}
+	m_slotProperties.append(slotProperties);
+}
+
+void PropertyIndex::removePart(const QString & moduleID) {
+	int slot = m_slots.value(moduleID, -1);
+	if (slot < 0) return;
+
+	m_slots.remove(moduleID);
+	m_moduleIDs[slot] = QString();
+
+	QHash<QString, Family>::iterator fit = m_families.find(m_slotFamilies.at(slot));
+	if (fit != m_families.end()) {
+		Family & family = fit.value();
+		setSlot(family.parts, slot, false);
+		setSlot(family.withProperties, slot, false);
+		QPair<QString, QString> prop;
+		foreach (prop, m_slotProperties.at(slot)) {
+			QMap<QString, QBitArray> & values = family.facets[prop.first];
+			QMap<QString, QBitArray>::iterator vit = values.find(prop.second);
+			if (vit == values.end()) continue;
+
+			setSlot(vit.value(), slot, false);
+			if (vit.value().count(true) == 0) {
+				// keep the distinct value lists honest
+				values.erase(vit);
+			}
+		}
+	}
+
+	m_slotProperties[slot].clear();
+}
+
+bool PropertyIndex::contains(const QString & moduleID) const {
+	return m_slots.contains(moduleID);
+}
+
+QStringList PropertyIndex::values(const QString & family, const QString & propName, bool distinct) const {
+	QStringList result;
+
+	QHash<QString, Family>::const_iterator fit = m_families.constFind(family);
+	if (fit == m_families.constEnd()) return result;
+
+	QHash<QString, QMap<QString, QBitArray> >::const_iterator pit = fit.value().facets.constFind(propName);
+	if (pit == fit.value().facets.constEnd()) return result;
+
+	// QMap keeps the values sorted, matching the old ORDER BY
+	QMap<QString, QBitArray>::const_iterator vit;
+	for (vit = pit.value().constBegin(); vit != pit.value().constEnd(); ++vit) {
+		int count = distinct ? 1 : vit.value().count(true);
+		for (int i = 0; i < count; i++) {
+			result << vit.key();
+		}
+	}
+
+	return result;
+}
+
+QBitArray PropertyIndex::facet(const Family & family, const QString & propName, const QString & value) const {
+	QHash<QString, QMap<QString, QBitArray> >::const_iterator pit = family.facets.constFind(propName);
+	if (pit == family.facets.constEnd()) return QBitArray();
+
+	return pit.value().value(value);
+}
+
+int PropertyIndex::firstSlot(const QBitArray & bits, bool coreOnly) const {
+	for (int i = 0; i < bits.size(); i++) {
+		if (!bits.testBit(i)) continue;
+		if (coreOnly && !testSlot(m_core, i)) continue;
+
+		return i;
+	}
+
+	return -1;
+}
+
+QString PropertyIndex::exactMatch(const Part * examplePart) const {
+	QHash<QString, Family>::const_iterator fit = m_families.constFind(examplePart->family());
+	if (fit == m_families.constEnd()) return ___emptyString___;
+
+	QBitArray bits = fit.value().parts;
+	foreach (PartProperty * prop, examplePart->properties()) {
+		bits &= facet(fit.value(), prop->name(), prop->value());
+	}
+
+	// core parts win, as they did with "order by part.core desc"
+	int slot = firstSlot(bits, true);
+	if (slot < 0) slot = firstSlot(bits, false);
+	if (slot < 0) return ___emptyString___;
+
+	return m_moduleIDs.at(slot);
+}
+
+QString PropertyIndex::closestMatch(const Part * examplePart, const QString & propertyName, const QString & propertyValue) const {
+	QHash<QString, Family>::const_iterator fit = m_families.constFind(examplePart->family());
+	if (fit == m_families.constEnd()) return ___emptyString___;
+
+	const Family & family = fit.value();
+	QBitArray candidates = propertyName.isEmpty()
+		? family.withProperties
+		: (family.parts & facet(family, propertyName, propertyValue));
+
+	QList<QBitArray> propBits;
+	int familyProps = 0;
+	foreach (PartProperty * prop, examplePart->properties()) {
+		if (prop->name().compare("family") == 0) {
+			// every candidate shares the family
+			if (prop->value().toLower().trimmed() == examplePart->family()) familyProps++;
+			continue;
+		}
+		propBits.append(facet(family, prop->name(), prop->value()));
+	}
+
+	// the first candidate with the most properties in common wins
+	int bestCount = 0;
+	QString result = ___emptyString___;
+	for (int i = 0; i < candidates.size(); i++) {
+		if (!candidates.testBit(i)) continue;
+
+		int count = familyProps;
+		foreach (const QBitArray & bits, propBits) {
+			if (testSlot(bits, i)) count++;
+		}
+		if (count > bestCount) {
+			bestCount = count;
+			result = m_moduleIDs.at(i);
+		}
+	}
+
+	return result;
+}
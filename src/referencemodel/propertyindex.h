@@ -0,0 +1,75 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef PROPERTYINDEX_H_
+#define PROPERTYINDEX_H_
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QBitArray>
+#include <QStringList>
+
+#include "daos.h"
+
+// In-memory faceted index over the reference parts: family -> property -> sorted distinct values -> bitset of parts.
+// Each part gets a slot (its bit position); slots are handed out in insertion order and never reused,
+// so the lowest set bit is also the part that was registered first.
+
+class PropertyIndex {
+public:
+	PropertyIndex();
+
+	void addPart(const Part *);
+	void removePart(const QString & moduleID);
+	bool contains(const QString & moduleID) const;
+	void clear();
+
+	QStringList values(const QString & family, const QString & propName, bool distinct) const;
+	QString exactMatch(const Part * examplePart) const;
+	QString closestMatch(const Part * examplePart, const QString & propertyName, const QString & propertyValue) const;
+
+protected:
+	struct Family {
+		QBitArray parts;
+		QBitArray withProperties;
+		QHash<QString, QMap<QString, QBitArray> > facets;
+	};
+
+	QBitArray facet(const Family &, const QString & propName, const QString & value) const;
+	int firstSlot(const QBitArray &, bool coreOnly) const;
+
+protected:
+	QHash<QString, Family> m_families;
+	QHash<QString, int> m_slots;						// moduleID -> slot
+	QStringList m_moduleIDs;							// slot -> moduleID; empty once removed
+	QList<QString> m_slotFamilies;
+	QList< QList< QPair<QString, QString> > > m_slotProperties;
+	QBitArray m_core;
+};
+
+#endif /* PROPERTYINDEX_H_ */
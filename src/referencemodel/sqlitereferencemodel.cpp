@@ -167,52 +167,13 @@ QString SqliteReferenceModel::retrieveModuleId(const Part *examplePart, const QS
 	QString propertyValue = ___emptyString___;
 
 	if(props.size() > 0) {
-		QString queryStr =
-			"SELECT moduleID FROM parts part \n"
-			"WHERE part.family = :family AND (1=1 ";
-		QString queryDebug =
-			"SELECT moduleID FROM parts part \n"
-			"WHERE part.family = '"+examplePart->family()+"' AND (1=1 ";
-		QHash<QString, QString> params;
-		for(int i=0; i<props.size(); i++) {
-			PartProperty *prop = props[i];
-			QString propParam = QString(":prop%1").arg(i);
-			queryStr += QString(" AND EXISTS (SELECT * FROM properties prop WHERE prop.part_id = part.id AND prop.name = %1_name AND prop.value = %1_value)").arg(propParam);
-			queryDebug += QString(" AND EXISTS (SELECT * FROM properties prop WHERE prop.part_id = part.id AND prop.name = '"+prop->name()+"' AND prop.value = '"+prop->value()+"')");
-			params[propParam+"_name"] = prop->name();
-			params[propParam+"_value"] = prop->value();
+		foreach (PartProperty * prop, props) {
 			if(prop->name() == propertyName) {
 				propertyValue = prop->value();
 			}
 		}
-		queryStr += ") order by part.core desc";
-		queryDebug += ") order by part.core desc";
 
-		QSqlQuery query;
-		query.prepare(queryStr);
-
-		query.bindValue(":family",examplePart->family());
-		foreach(QString name, params.uniqueKeys()) {
-			query.bindValue(name,params[name]);
-		}
-
-		QString moduleId = ___emptyString___;
-		if(query.exec()) {
-			//DebugDialog::debug("SQLITE: retrieving: \n"+queryDebug);
-			if(query.next()) {
-				moduleId =  query.value(0).toString(); //grab the first
-			}
-			//DebugDialog::debug("SQLITE: found: "+moduleId);
-			query.clear();
-		} else {
-			moduleId = ___emptyString___;
-			DebugDialog::debug(
-				"SQLITE: couldn't retrieve part\n"
-				"\t "+query.lastQuery()+"\n"
-				"\t ERROR DRIVER: "+query.lastError().driverText()+"\n"
-				"\t ERROR DB: "+query.lastError().databaseText()+"\n"
-			);
-		}
+		QString moduleId = m_propertyIndex.exactMatch(examplePart);
 
 		if(moduleId != ___emptyString___) {
 			m_lastWasExactMatch = true;
@@ -229,88 +190,7 @@ QString SqliteReferenceModel::retrieveModuleId(const Part *examplePart, const QS
 }
 
 QString SqliteReferenceModel::closestMatchId(const Part *examplePart, const QString &propertyName, const QString &propertyValue) {
-	QStringList possibleMatches = getPossibleMatches(examplePart,propertyName, propertyValue);
-	return getClosestMatch(examplePart, possibleMatches);
-}
-
-QStringList SqliteReferenceModel::getPossibleMatches(const Part *examplePart, const QString &propertyName, const QString &propertyValue) {
-	QStringList result;
-	QString queryStr =
-		"SELECT moduleID FROM parts part \n"
-		"WHERE part.family = :family AND EXISTS ( \n"
-			"SELECT * FROM properties prop \n"
-			"WHERE prop.part_id = part.id %1 \n"
-		") ";
-	queryStr = queryStr.arg((propertyName.isEmpty()) ? "" : "AND prop.name = :prop_name  AND prop.value = :prop_value ");
-	QString dbgQueryStr =
-		"SELECT moduleID FROM parts part \n"
-		"WHERE part.family = "+examplePart->family()+" AND EXISTS ( \n"
-			"SELECT * FROM properties prop \n"
-			"WHERE prop.part_id = part.id %1 \n"
-		") ";
-    dbgQueryStr = dbgQueryStr.arg((propertyName.isEmpty()) ? QString("") : QString("AND prop.name = ")+propertyName+"  AND prop.value = "+propertyValue);
-	QSqlQuery query;
-	query.prepare(queryStr);
-
-	query.bindValue(":family",examplePart->family());
-	if (!propertyName.isEmpty()) {
-		query.bindValue(":prop_name",propertyName);
-		query.bindValue(":prop_value",propertyValue);
-	}
-
-	Q_UNUSED(dbgQueryStr);
-	//DebugDialog::debug(dbgQueryStr);
-
-	QString moduleId = ___emptyString___;
-	if(query.exec()) {
-		while(query.next()) {
-			result << query.value(0).toString();
-		}
-		//DebugDialog::debug(QString("SQLITE: %1 possible matches found").arg(result.size()));
-		query.clear();
-	} else {
-		moduleId = ___emptyString___;
-		DebugDialog::debug(
-			"SQLITE: couldn't retrieve part\n"
-			"\t "+query.lastQuery()+"\n"
-			"\t ERROR DRIVER: "+query.lastError().driverText()+"\n"
-			"\t ERROR DB: "+query.lastError().databaseText()+"\n"
-		);
-	}
-
-	return result;
-}
-
-QString SqliteReferenceModel::getClosestMatch(const Part *examplePart, QStringList possibleMatches) {
-	int propsInCommonCount = 0;
-	int propsInCommonCountAux = 0;
-	QString result = ___emptyString___;
-	foreach(QString modId, possibleMatches) {
-		propsInCommonCountAux = countPropsInCommon(examplePart,retrieveModelPart(modId));
-		if(propsInCommonCountAux > propsInCommonCount) {
-			result = modId;
-			propsInCommonCount = propsInCommonCountAux;
-		}
-	}
-	return result;
-}
-
-int SqliteReferenceModel::countPropsInCommon(const Part *part1, const ModelPart *part2) {
-	if (part1 == NULL || part2 == NULL) {
-		DebugDialog::debug("countPropsInCommon failure");
-		return 0;
-	}
-
-	int result = 0;
-	PartPropertyList props1 = part1->properties();
-	QMultiHash<QString,QString> props2 = part2->properties();
-	foreach(PartProperty *prop1, props1) {
-		QStringList values = props2.values(prop1->name());
-		if(values.contains(prop1->value())) {
-			result++;
-		}
-	}
-	return result;
+	return m_propertyIndex.closestMatch(examplePart, propertyName, propertyValue);
 }
 
 bool SqliteReferenceModel::lastWasExactMatch() {
@@ -321,6 +201,10 @@ bool SqliteReferenceModel::addPartAux(ModelPart * newModel) {
 	try {
 		Part *part = Part::from(newModel);
 		bool result = addPart(part);
+		if (result) {
+			// only index what the database actually holds
+			m_propertyIndex.addPart(part);
+		}
 		delete part;
 		return result;
 	}
@@ -356,6 +240,7 @@ bool SqliteReferenceModel::updatePart(ModelPart * newModel) {
 	if(m_swappingEnabled) {
 		qlonglong partId = this->partId(newModel->moduleID());
 		if(partId != -1) {
+			m_propertyIndex.removePart(newModel->moduleID());
 			removePart(partId);
 			removeProperties(partId);
 			return addPartAux(newModel);
@@ -423,33 +308,7 @@ bool SqliteReferenceModel::insertProperty(PartProperty *property) {
 }
 
 QStringList SqliteReferenceModel::values(const QString &family, const QString &propName, bool distinct) {
-	QStringList retval;
-
-	QSqlQuery query;
-	query.prepare(QString(
-		"SELECT %1 prop.value FROM properties prop JOIN parts PART ON part.id = prop.part_id \n"
-		"WHERE part.family = :family AND prop.name = :propName ORDER BY prop.value \n"
-		).arg(distinct ? " DISTINCT ":"")
-	);
-	query.bindValue(":family",family);
-	query.bindValue(":propName",propName);
-
-	if(query.exec()) {
-		while(query.next()) {
-			retval << query.value(0).toString();
-		}
-		query.clear();
-	} else {
-		DebugDialog::debug(
-			"SQLITE: couldn't retrieve part\n"
-			"\t "+query.lastQuery()+"\n"
-			"\t ERROR DRIVER: "+query.lastError().driverText()+"\n"
-			"\t ERROR DB: "+query.lastError().databaseText()+"\n"
-		);
-		m_swappingEnabled = false;
-	}
-
-	return retval;
+	return m_propertyIndex.values(family, propName, distinct);
 }
 
 void SqliteReferenceModel::recordProperty(const QString &name, const QString &value) {
@@ -462,7 +321,7 @@ bool SqliteReferenceModel::swapEnabled() {
 }
 
 bool SqliteReferenceModel::containsModelPart(const QString & moduleID) {
-	return partId(moduleID) != -1;
+	return m_propertyIndex.contains(moduleID);
 }
 
 qlonglong SqliteReferenceModel::partId(QString moduleID) {
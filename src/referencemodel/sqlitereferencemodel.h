@@ -35,6 +35,7 @@ $Date: 2011-07-08 04:16:29 -0700 (Fri, 08 Jul 2011) $
 
 #include "referencemodel.h"
 #include "daos.h"
+#include "propertyindex.h"
 
 class SqliteReferenceModel : public ReferenceModel {
 	Q_OBJECT
@@ -74,9 +75,6 @@ class SqliteReferenceModel : public ReferenceModel {
 		bool addPartAux(ModelPart * newModel);
 
 		QString closestMatchId(const Part *examplePart, const QString &propertyName, const QString &propertyValue);
-		QStringList getPossibleMatches(const Part *examplePart, const QString &propertyName, const QString &propertyValue);
-		QString getClosestMatch(const Part *examplePart, QStringList possibleMatches);
-		int countPropsInCommon(const Part *part1, const ModelPart *part2);
 
 		bool createConnection();
 		void deleteConnection();
@@ -90,6 +88,7 @@ class SqliteReferenceModel : public ReferenceModel {
 		volatile bool m_lastWasExactMatch;
 		bool m_init;
 		QMultiHash<QString /*name*/, QString /*value*/> m_recordedProperties;
+		PropertyIndex m_propertyIndex;					// answers the interactive queries; the database is only written to
 };
 
 #endif /* SQLITEREFERENCEMODEL_H_ */
@@ -141,6 +141,14 @@ void InfoGraphicsView::noteSizeChanged(ItemBase * itemBase, const QRectF & oldRe
 	Q_UNUSED(newRect);
 }
 
+void InfoGraphicsView::itemGeometryChanged(ItemBase * itemBase) {
+	Q_UNUSED(itemBase);
+}
+
+void InfoGraphicsView::itemLeavingScene(ItemBase * itemBase) {
+	Q_UNUSED(itemBase);
+}
+
 bool InfoGraphicsView::spaceBarIsPressed() {
 	return false;
 }
@@ -61,6 +61,8 @@ public:
 	virtual void partLabelMoved(ItemBase *, QPointF oldPos, QPointF oldOffset, QPointF newPos, QPointF newOffset);
 	virtual void rotateFlipPartLabel(ItemBase *, double degrees, Qt::Orientations flipDirection);
 	virtual void noteSizeChanged(ItemBase * itemBase, const QRectF & oldRect, const QRectF & newRect);
+	virtual void itemGeometryChanged(ItemBase *);
+	virtual void itemLeavingScene(ItemBase *);
 
 	virtual bool spaceBarIsPressed(); 
 	virtual void initWire(class Wire *, int penWidth);
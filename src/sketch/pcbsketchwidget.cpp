@@ -69,6 +69,7 @@ $Date: 2012-04-16 06:00:20 -0700 (Mon, 16 Apr 2012) $
 static const int MAX_INT = std::numeric_limits<int>::max();
 static const double BlurBy = 3.5;
 static const double StrokeWidthIncrement = 50;
+static const int LiveDrcDelay = 150;				// milliseconds of quiet before a live drc pass
 
 static QString PCBTraceColor1 = "trace1";
 static QString PCBTraceColor = "trace";
@@ -126,6 +127,18 @@ PCBSketchWidget::PCBSketchWidget(ViewIdentifierClass::ViewIdentifier viewIdentif
 
 	m_routingStatus.zero();
 	m_cleanType = noClean;
+
+	m_liveDrc = false;
+	m_liveDrcRouter = NULL;
+	m_displayMessageBoxes = true;
+	m_liveDrcTimer.setSingleShot(true);
+	m_liveDrcTimer.setInterval(LiveDrcDelay);
+	connect(&m_liveDrcTimer, SIGNAL(timeout()), this, SLOT(liveDrcSlot()));
+}
+
+PCBSketchWidget::~PCBSketchWidget()
+{
+	clearLiveDrc();
 }
 
 void PCBSketchWidget::setWireVisible(Wire * wire)
@@ -1641,13 +1654,11 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 	QList<ItemBase *> boards = findBoard();
     // barf an error if there's no board
     if (boards.count() == 0) {
-        QMessageBox::critical(NULL, tr("Fritzing"),
-                   tr("Your sketch does not have a board yet!  Please add a PCB in order to use copper fill."));
+        displayMessage(tr("Your sketch does not have a board yet!  Please add a PCB in order to use copper fill."));
         return false;
     }
     if (boards.count() > 1) {
-        QMessageBox::critical(NULL, tr("Fritzing"),
-                   tr("Copper Fill: multiple boards are not supported."));
+        displayMessage(tr("Copper Fill: multiple boards are not supported."));
         return false;
     }
 
@@ -1659,7 +1670,8 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 
 		if (!gotTrueSeeds && (seeds.count() != 1)) {
 			QString message =  tr("Please designate one or more ground fill seeds before doing a ground fill.\n\n");							
-			setGroundFillSeeds(message);
+			if (m_displayMessageBoxes) setGroundFillSeeds(message);
+			else DebugDialog::debug(message);
 			return false;
 		}
 
@@ -1673,7 +1685,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 	bool empty;
 	QString boardSvg = renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, boardImageSize, board, GraphicsUtils::StandardFritzingDPI, false, false, false, empty);
 	if (boardSvg.isEmpty()) {
-        QMessageBox::critical(NULL, tr("Fritzing"), tr("Fritzing error: unable to render board svg (1)."));
+        displayMessage(tr("Fritzing error: unable to render board svg (1)."));
 		return false;
 	}
 
@@ -1686,7 +1698,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 	QString svg = renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, copperImageSize, board, GraphicsUtils::StandardFritzingDPI, false, false, true, empty);
 	if (fillGroundTraces) showGroundTraces(seeds, true);
 	if (svg.isEmpty()) {
-        QMessageBox::critical(NULL, tr("Fritzing"), tr("Fritzing error: unable to render copper svg (1)."));
+        displayMessage(tr("Fritzing error: unable to render copper svg (1)."));
 		return false;
 	}
 
@@ -1698,7 +1710,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 		svg2 = renderToSVG(FSvgRenderer::printerScale(), viewLayerIDs, true, copperImageSize, board, GraphicsUtils::StandardFritzingDPI, false, false, true, empty);
 		if (fillGroundTraces) showGroundTraces(seeds, true);
 		if (svg2.isEmpty()) {
-			QMessageBox::critical(NULL, tr("Fritzing"), tr("Fritzing error: unable to render copper svg (1)."));
+			displayMessage(tr("Fritzing error: unable to render copper svg (1)."));
 			return false;
 		}
 	}
@@ -1711,6 +1723,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 	gpg.setLayerName("groundplane");
 	gpg.setStrokeWidthIncrement(StrokeWidthIncrement);
 	gpg.setMinRunSize(10, 10);
+	gpg.setTraceContours(true);
 	if (fillGroundTraces) {
 		connect(&gpg, SIGNAL(postImageSignal(GroundPlaneGenerator *, QImage *, QGraphicsItem *)), 
 				this, SLOT(postImageSlot(GroundPlaneGenerator *, QImage *, QGraphicsItem *)));
@@ -1719,7 +1732,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 	bool result = gpg.generateGroundPlane(boardSvg, boardImageSize, svg, copperImageSize, exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
 											ViewLayer::Copper0Color);
 	if (result == false) {
-        QMessageBox::critical(NULL, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (1)."));
+        displayMessage(tr("Fritzing error: unable to write copper fill (1)."));
 		return false;
 	}
 
@@ -1729,6 +1742,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 		gpg2.setLayerName("groundplane1");
 		gpg2.setStrokeWidthIncrement(StrokeWidthIncrement);
 		gpg2.setMinRunSize(10, 10);
+		gpg2.setTraceContours(true);
 		if (fillGroundTraces) {
 			connect(&gpg2, SIGNAL(postImageSignal(GroundPlaneGenerator *, QImage *, QGraphicsItem *)), 
 					this, SLOT(postImageSlot(GroundPlaneGenerator *, QImage *, QGraphicsItem *)));
@@ -1736,7 +1750,7 @@ bool PCBSketchWidget::groundFill(bool fillGroundTraces, QUndoCommand * parentCom
 		bool result = gpg2.generateGroundPlane(boardSvg, boardImageSize, svg2, copperImageSize, exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */,
 												ViewLayer::Copper1Color);
 		if (result == false) {
-			QMessageBox::critical(NULL, tr("Fritzing"), tr("Fritzing error: unable to write copper fill (2)."));
+			displayMessage(tr("Fritzing error: unable to write copper fill (2)."));
 			return false;
 		}
 	}
@@ -1831,6 +1845,7 @@ QString PCBSketchWidget::generateCopperFillUnit(ItemBase * itemBase, QPointF whe
 	gpg.setStrokeWidthIncrement(StrokeWidthIncrement);
 	gpg.setLayerName(gpLayerName);
 	gpg.setMinRunSize(10, 10);
+	gpg.setTraceContours(true);
 	bool result = gpg.generateGroundPlaneUnit(boardSvg, boardImageSize, svg, copperImageSize, exceptions, board, GraphicsUtils::StandardFritzingDPI / 2.0  /* 2 MIL */, 
 												color, whereToStart);
 
@@ -2313,3 +2328,116 @@ void PCBSketchWidget::shiftHoles() {
 		}		
 	}
 }
+
+void PCBSketchWidget::setDisplayMessageBoxes(bool displayMessageBoxes)
+{
+	m_displayMessageBoxes = displayMessageBoxes;
+}
+
+void PCBSketchWidget::displayMessage(const QString & message)
+{
+	// don't use QMessageBox if running as a service
+	if (!m_displayMessageBoxes) {
+		DebugDialog::debug(message);
+		return;
+	}
+
+	QMessageBox::critical(NULL, tr("Fritzing"), message);
+}
+
+void PCBSketchWidget::setLiveDrc(bool liveDrc)
+{
+	// always start from scratch, since a full drc or autoroute clears the highlights
+	m_liveDrc = liveDrc;
+	clearLiveDrc();
+	setTraceGeometryChanges(m_liveDrc);
+	if (m_liveDrc) {
+		m_liveDrcTimer.start();
+	}
+	else {
+		m_liveDrcTimer.stop();
+	}
+}
+
+bool PCBSketchWidget::liveDrc()
+{
+	return m_liveDrc;
+}
+
+void PCBSketchWidget::checkLiveDrc(const QList< QPointer<ConnectorItem> > & rewired)
+{
+	// restarting the timer debounces the check while dragging
+	if (!m_liveDrc) return;
+
+	if (m_liveDrcRouter != NULL) {
+		m_liveDrcRouter->liveConnectionsChanged(rewired);
+	}
+	m_liveDrcTimer.start();
+}
+
+void PCBSketchWidget::itemGeometryChanged(ItemBase * itemBase)
+{
+	if (!m_liveDrc) return;
+
+	// traces added while live drc is on have to report their moves as well
+	Wire * wire = qobject_cast<Wire *>(itemBase);
+	if (wire != NULL && wire->getTrace() && !(wire->flags() & QGraphicsItem::ItemSendsGeometryChanges)) {
+		wire->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
+	}
+
+	if (m_liveDrcRouter == NULL) return;
+
+	m_liveDrcRouter->liveItemChanged(itemBase);
+}
+
+void PCBSketchWidget::itemLeavingScene(ItemBase * itemBase)
+{
+	if (m_liveDrcRouter == NULL) return;
+
+	m_liveDrcRouter->liveItemLeaving(itemBase);
+}
+
+void PCBSketchWidget::setTraceGeometryChanges(bool on)
+{
+	// wires only pay for position change notifications while live drc is listening; parts always send them
+	foreach (QGraphicsItem * item, scene()->items()) {
+		Wire * wire = dynamic_cast<Wire *>(item);
+		if (wire == NULL) continue;
+		if (!wire->getTrace()) continue;
+
+		wire->setFlag(QGraphicsItem::ItemSendsGeometryChanges, on);
+	}
+}
+
+void PCBSketchWidget::clearLiveDrc()
+{
+	if (m_liveDrcRouter == NULL) return;
+
+	m_liveDrcRouter->drcClean();
+	delete m_liveDrcRouter;
+	m_liveDrcRouter = NULL;
+}
+
+void PCBSketchWidget::liveDrcSlot()
+{
+	if (!m_liveDrc) return;
+
+	if (ProcessEventBlocker::isProcessing()) {
+		// autorouting or otherwise busy: try again later
+		m_liveDrcTimer.start();
+		return;
+	}
+
+	if (m_liveDrcRouter != NULL && !m_liveDrcRouter->liveDrcValid()) {
+		clearLiveDrc();
+	}
+
+	if (m_liveDrcRouter == NULL) {
+		m_liveDrcRouter = new CMRouter(this);
+	}
+
+	if (!m_liveDrcRouter->liveDrc()) {
+		// no board (or more than one)
+		clearLiveDrc();
+	}
+}
@@ -29,6 +29,7 @@ $Date: 2012-04-12 10:58:05 -0700 (Thu, 12 Apr 2012) $
 
 #include "sketchwidget.h"
 #include <QVector>
+#include <QTimer>
 
 class PCBSketchWidget : public SketchWidget
 {
@@ -36,6 +37,7 @@ class PCBSketchWidget : public SketchWidget
 
 public:
     PCBSketchWidget(ViewIdentifierClass::ViewIdentifier, QWidget *parent=0);
+	~PCBSketchWidget();
 
 	void addViewLayers();
 	bool canDeleteItem(QGraphicsItem * item, int count);
@@ -99,6 +101,8 @@ public:
 	ViewGeometry::WireFlag getTraceFlag();
 	void hideCopperLogoItems(QList<ItemBase *> & copperLogoItems);
 	void restoreCopperLogoItems(QList<ItemBase *> & copperLogoItems);
+	void setLiveDrc(bool);
+	bool liveDrc();
 
 public:
 	static QSizeF jumperItemSize();
@@ -158,6 +162,12 @@ protected:
 	bool collectGroundFillSeeds(QList<ConnectorItem *> & seeds, bool includePotential);
 	void shiftHoles();
 	void selectAllXTraces(bool autoroutable, const QString & cmdText) ;
+	void checkLiveDrc(const QList< QPointer<ConnectorItem> > & rewired);
+	void clearLiveDrc();
+	void setDisplayMessageBoxes(bool);
+	void itemGeometryChanged(ItemBase *);
+	void itemLeavingScene(ItemBase *);
+	void setTraceGeometryChanges(bool);
 
 signals:
 	void subSwapSignal(SketchWidget *, ItemBase *, ViewLayer::ViewLayerSpec, QUndoCommand * parentCommand);
@@ -171,11 +181,13 @@ protected:
 	static void clearDistances();
 	static int calcDistance(Wire * wire, ConnectorItem * end, int distance, QList<Wire *> & distanceWires, bool & fromConnector0);
 	static int calcDistanceAux(ConnectorItem * from, ConnectorItem * to, int distance, QList<Wire *> & distanceWires);
+	void displayMessage(const QString & message);
 
 protected slots:
 	void alignJumperItem(class JumperItem *, QPointF &);
 	void wireSplitSlot(class Wire*, QPointF newPos, QPointF oldPos, QLineF oldLine);
 	void postImageSlot(class GroundPlaneGenerator *, QImage * image, QGraphicsItem * board);
+	void liveDrcSlot();
 
 protected:
 	CleanType m_cleanType;
@@ -183,6 +195,10 @@ protected:
 	QPointer<class JumperItem> m_resizingJumperItem;
 	QPointer<class ResizableBoard> m_resizingBoard;
 	QList<ConnectorItem *> * m_groundFillSeeds;
+	bool m_liveDrc;
+	QTimer m_liveDrcTimer;
+	class CMRouter * m_liveDrcRouter;
+	bool m_displayMessageBoxes;
 
 protected:
 	static QSizeF m_jumperItemSize;
@@ -43,7 +43,9 @@ $Date: 2012-04-18 21:45:53 -0700 (Wed, 18 Apr 2012) $
 #include <QApplication>
 #include <QDomElement>
 #include <QSettings>
+#include <QtConcurrentMap>
 #include <limits>
+#include <qmath.h>
 
 #include "../items/partfactory.h"
 #include "../items/paletteitem.h"
@@ -89,6 +91,7 @@ $Date: 2012-04-18 21:45:53 -0700 (Wed, 18 Apr 2012) $
 #include "../items/capacitor.h"
 #include "../utils/graphutils.h"
 #include "../utils/ratsnestcolors.h"
+#include "../utils/tracespan.h"
 
 /////////////////////////////////////////////////////////////////////
 
@@ -114,6 +117,7 @@ static const double CloseEnough = 0.5;  // in pixels, for swapping into the brea
 const int SketchWidget::MoveAutoScrollThreshold = 5;
 const int SketchWidget::DragAutoScrollThreshold = 10;
 static const int AutoRepeatDelay = 750;
+static const int DragProxyThreshold = 150;			// selections at least this big are dragged as a single outline item
 const int SketchWidget::PropChangeDelay = 100;
 
 /////////////////////////////////////////////////////////////////////
@@ -125,6 +129,30 @@ bool zLessThan(QGraphicsItem * & p1, QGraphicsItem * & p2)
 
 /////////////////////////////////////////////////////////////////////
 
+struct NetJob {
+	QList<ConnectorItem *> partConnectorItems;
+	bool doRatsnest;
+	bool doScore;
+	RatsnestSnapshot ratsnestSnapshot;
+	ScoreSnapshot scoreSnapshot;
+	QList< QPair<int, int> > ratsnestPairs;
+	RoutingStatus routingStatus;
+};
+
+static void computeNetJob(NetJob & netJob)
+{
+	// runs on a pool thread: it only sees the snapshots, never the scene
+	netJob.routingStatus.zero();
+	if (netJob.doScore) {
+		GraphUtils::scoreSnapshot(netJob.scoreSnapshot, netJob.routingStatus);
+	}
+	if (netJob.doRatsnest) {
+		GraphUtils::chooseRatsnestPairs(netJob.ratsnestSnapshot, netJob.ratsnestPairs);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////
+
 SketchWidget::SketchWidget(ViewIdentifierClass::ViewIdentifier viewIdentifier, QWidget *parent, int size, int minSize)
     : InfoGraphicsView(parent)
 {
@@ -138,6 +166,10 @@ SketchWidget::SketchWidget(ViewIdentifierClass::ViewIdentifier viewIdentifier, Q
 	m_addedDefaultPart = NULL;
 	m_movingItem = NULL;
 	m_movingSVGRenderer = NULL;
+	m_dragProxy = NULL;
+	m_dragProxyPending = false;
+	QSettings settings;
+	m_dragProxyThreshold = settings.value("dragProxyThreshold", DragProxyThreshold).toInt();
 	m_clearSceneRect = false;
 	m_draggingBendpoint = false;
 	m_zoom = 100;
@@ -152,6 +184,7 @@ SketchWidget::SketchWidget(ViewIdentifierClass::ViewIdentifier viewIdentifier, Q
 	m_current = false;
 	m_ignoreSelectionChangeEvents = 0;
 	m_droppingItem = NULL;
+	m_renderCacheDepth = 0;
 	m_chainDrag = false;
 	m_bendpointWire = m_connectorDragWire = NULL;
 	m_tempDragWireCommand = m_holdingSelectItemCommand = NULL;
@@ -229,6 +262,8 @@ void SketchWidget::setUndoStack(WaitPushUndoStack * undoStack) {
 }
 
 void SketchWidget::loadFromModelParts(QList<ModelPart *> & modelParts, BaseCommand::CrossViewType crossViewType, QUndoCommand * parentCommand, bool offsetPaste, const QRectF * boundingRect, bool seekOutsideConnections, QList<long> & newIDs) {
+	TraceSpan traceSpan("SketchWidget::loadFromModelParts");
+
 	clearHoldingSelectItem();
 
 	if (parentCommand) {
@@ -815,6 +850,9 @@ PaletteItem* SketchWidget::addPartItem(ModelPart * modelPart, ViewLayer::ViewLay
 
 void SketchWidget::addToScene(ItemBase * item, ViewLayer::ViewLayerID viewLayerID) {
 	scene()->addItem(item);
+	if (m_lowDetail) {
+		setLowDetailCache(item, true);
+	}
  	item->setSelected(true);
  	item->setHidden(!layerIsVisible(viewLayerID));
  	item->setInactive(!layerIsActive(viewLayerID));
@@ -1033,12 +1071,20 @@ bool isVirtualWireConnector(ConnectorItem * toConnectorItem) {
 }
 
 void SketchWidget::deleteMiddle(QHash<ItemBase *, SketchWidget *> & deletedItems, QUndoCommand * parentCommand) {
+	// one bulk command per view instead of a ChangeConnectionCommand per connection
+	QHash<SketchWidget *, BulkConnectionCommand *> bulkCommands;
 	foreach (ItemBase * itemBase, deletedItems.keys()) {
+		SketchWidget * sketchWidget = deletedItems.value(itemBase);
+		BulkConnectionCommand * bulkCommand = bulkCommands.value(sketchWidget, NULL);
+		if (bulkCommand == NULL) {
+			bulkCommand = new BulkConnectionCommand(sketchWidget, BaseCommand::CrossView, parentCommand);
+			bulkCommands.insert(sketchWidget, bulkCommand);
+		}
 		foreach (ConnectorItem * fromConnectorItem, itemBase->cachedConnectorItems()) {
 			foreach (ConnectorItem * toConnectorItem, fromConnectorItem->connectedToItems()) {
-				deletedItems.value(itemBase)->extendChangeConnectionCommand(BaseCommand::CrossView, fromConnectorItem, toConnectorItem,
+				sketchWidget->extendChangeConnectionCommand(bulkCommand, fromConnectorItem, toConnectorItem,
 											  ViewLayer::specFromID(fromConnectorItem->attachedToViewLayerID()),
-											  false, parentCommand);
+											  false);
 				fromConnectorItem->tempRemove(toConnectorItem, false);
 				toConnectorItem->tempRemove(fromConnectorItem, false);
 			}
@@ -1046,9 +1092,9 @@ void SketchWidget::deleteMiddle(QHash<ItemBase *, SketchWidget *> & deletedItems
 			fromConnectorItem = fromConnectorItem->getCrossLayerConnectorItem();
 			if (fromConnectorItem) {
 				foreach (ConnectorItem * toConnectorItem, fromConnectorItem->connectedToItems()) {
-					deletedItems.value(itemBase)->extendChangeConnectionCommand(BaseCommand::CrossView, fromConnectorItem, toConnectorItem,
+					sketchWidget->extendChangeConnectionCommand(bulkCommand, fromConnectorItem, toConnectorItem,
 												  ViewLayer::specFromID(fromConnectorItem->attachedToViewLayerID()),
-												  false, parentCommand);
+												  false);
 					fromConnectorItem->tempRemove(toConnectorItem, false);
 					toConnectorItem->tempRemove(fromConnectorItem, false);
 				}
@@ -1156,6 +1202,24 @@ ChangeConnectionCommand * SketchWidget::extendChangeConnectionCommand(BaseComman
 								viewLayerSpec, connect, parentCommand);
 }
 
+bool SketchWidget::extendChangeConnectionCommand(BulkConnectionCommand * bulkCommand,
+												 ConnectorItem * fromConnectorItem, ConnectorItem * toConnectorItem,
+												 ViewLayer::ViewLayerSpec viewLayerSpec, bool connect)
+{
+	// same as above, but the change is appended as a row of a bulk command
+
+	ItemBase * fromItem = fromConnectorItem->attachedTo();
+	if (fromItem == NULL) return false;
+
+	ItemBase * toItem = toConnectorItem->attachedTo();
+	if (toItem == NULL) return false;
+
+	bulkCommand->addConnection(fromItem->id(), fromConnectorItem->connectorSharedID(),
+								toItem->id(), toConnectorItem->connectorSharedID(),
+								viewLayerSpec, connect);
+	return true;
+}
+
 
 long SketchWidget::createWire(ConnectorItem * from, ConnectorItem * to, 
 							  ViewGeometry::WireFlags wireFlags, bool dontUpdate,
@@ -1818,6 +1882,7 @@ void SketchWidget::dropEvent(QDropEvent *event)
 
 		ConnectorItem::clearEqualPotentialDisplay();
 		if (event->source() == this) {
+			endDragProxy();
 			checkMoved();
 			m_savedItems.clear();
 			m_savedWires.clear();
@@ -2187,12 +2252,14 @@ void SketchWidget::prepMove(ItemBase * originatingItem, bool rubberBandLegEnable
 	//DebugDialog::debug("prep move check under = false");
 	QSet<Wire *> wires;
 	QList<ItemBase *> items;
+	QSet<ItemBase *> itemSet;			// mirrors items, for membership tests
 	foreach (QGraphicsItem * gitem,  this->scene()->selectedItems()) {
 		ItemBase *itemBase = dynamic_cast<ItemBase *>(gitem);
 		if (itemBase == NULL) continue;
 		if (itemBase->moveLock()) continue;
 
 		items.append(itemBase);
+		itemSet.insert(itemBase);
 	}
 
 
@@ -2221,8 +2288,9 @@ void SketchWidget::prepMove(ItemBase * originatingItem, bool rubberBandLegEnable
 					}
 					else {
 						m_savedItems.insert(sitemBase->layerKinChief()->id(), sitemBase);
-						if (!items.contains(sitemBase)) {
+						if (!itemSet.contains(sitemBase)) {
 							items.append(sitemBase);
+							itemSet.insert(sitemBase);
 						}
 					}
 				}
@@ -2237,8 +2305,9 @@ void SketchWidget::prepMove(ItemBase * originatingItem, bool rubberBandLegEnable
 			}
 		}
 		foreach (ItemBase * sitemBase, set) {
-			if (!items.contains(sitemBase)) {
+			if (!itemSet.contains(sitemBase)) {
 				items.append(sitemBase);
+				itemSet.insert(sitemBase);
 			}
 		}
 		chief->collectWireConnectees(wires);
@@ -2802,6 +2871,7 @@ void SketchWidget::mouseMoveEvent(QMouseEvent *event) {
 
 				drag->exec();
 
+				endDragProxy();				// in case the drag was cancelled
                 delete m_movingSVGRenderer;
 				m_movingSVGRenderer = NULL;
 				return;
@@ -2925,8 +2995,23 @@ void SketchWidget::moveItems(QPoint globalPos, bool checkAutoScrollFlag, bool ru
 			//DebugDialog::debug(QString("disconnecting from female %1").arg(item->instanceTitle()));
 			disconnectFromFemale(item, m_savedItems, m_moveDisconnectedFromFemale, false, rubberBandLegEnabled, NULL);
 		}
+
+		startDragProxy();
+	}
+
+	if (m_dragProxy) {
+		// only the outline follows the mouse; the parts are moved once, when the drag ends
+		m_dragProxy->setPos(scenePos - m_movingSVGOffset);
+		m_dragProxyScenePos = scenePos;
+		m_dragProxyPending = true;
+		return;
 	}
 
+	moveItemsAux(scenePos);
+}
+
+void SketchWidget::moveItemsAux(QPointF scenePos)
+{
 	foreach (ItemBase * itemBase, m_savedItems) {
 		QPointF currentParentPos = itemBase->mapToParent(itemBase->mapFromScene(scenePos));
 		QPointF buttonDownParentPos = itemBase->mapToParent(itemBase->mapFromScene(m_mousePressScenePos));
@@ -2954,15 +3039,52 @@ void SketchWidget::moveItems(QPoint globalPos, bool checkAutoScrollFlag, bool ru
 		wire->simpleConnectedMoved(m_savedWires.value(wire));
 	}
 
+	checkLiveDrc(QList< QPointer<ConnectorItem> >());
+
 	//DebugDialog::debug(QString("done move items %1").arg(QTime::currentTime().msec()) );
 
 }
 
+bool SketchWidget::startDragProxy()
+{
+	// only mouse drags have an outline renderer; arrow-key moves always move the parts directly
+	if (m_movingSVGRenderer == NULL) return false;
+	if (m_dragProxyThreshold <= 0) return false;
+	if (m_savedItems.count() < m_dragProxyThreshold) return false;
+
+	m_dragProxy = new QGraphicsSvgItem();
+	m_dragProxy->setSharedRenderer(m_movingSVGRenderer);
+	m_dragProxy->setCacheMode(QGraphicsItem::DeviceCoordinateCache);			// rendered once, then blitted
+	m_dragProxy->setAcceptedMouseButtons(Qt::NoButton);
+	m_dragProxy->setZValue(std::numeric_limits<double>::max());
+	scene()->addItem(m_dragProxy);
+	m_dragProxy->setPos(m_mousePressScenePos - m_movingSVGOffset);
+	m_dragProxyPending = false;
+	return true;
+}
+
+void SketchWidget::endDragProxy()
+{
+	if (m_dragProxy == NULL) return;
+
+	delete m_dragProxy;
+	m_dragProxy = NULL;
+
+	if (m_dragProxyPending) {
+		m_dragProxyPending = false;
+		moveItemsAux(m_dragProxyScenePos);
+	}
+}
+
 
 void SketchWidget::findConnectorsUnder(ItemBase * item) {
 	Q_UNUSED(item);
 }
 
+void SketchWidget::checkLiveDrc(const QList< QPointer<ConnectorItem> > & rewired) {
+	Q_UNUSED(rewired);
+}
+
 void SketchWidget::mouseReleaseEvent(QMouseEvent *event) {
 	//setRenderHint(QPainter::Antialiasing, true);
 
@@ -3349,7 +3471,7 @@ void SketchWidget::prepLegBendpointMove(ConnectorItem * from, int index, QPointF
 	mlbc->setUndoOnly();
 
 	if (changeConnections) {
-		QList< QPointer<ConnectorItem> > former = from->connectedToItems();
+		ConnectorItemList former = from->connectedToItems();
 
 		QString prefix;
 		QString suffix;
@@ -3534,7 +3656,7 @@ void SketchWidget::wireChangedSlot(Wire* wire, const QLineF & oldLine, const QLi
 		new CheckStickyCommand(this, BaseCommand::SingleView, toWire->id(), false, CheckStickyCommand::RedoOnly, parentCommand);
 	}
 
-	QList< QPointer<ConnectorItem> > former = from->connectedToItems();
+	ConnectorItemList former = from->connectedToItems();
 
 	QString prefix;
 	QString suffix;
@@ -6298,17 +6420,24 @@ void SketchWidget::updateRoutingStatus(CleanUpWiresCommand* command, RoutingStat
 
 void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manual) 
 {
+	TraceSpan traceSpan("SketchWidget::updateRoutingStatus");
+
 	//DebugDialog::debug(QString("update routing status %1 %2 %3")
 	//	.arg(m_viewIdentifier) 
 	//	.arg(m_ratsnestUpdateConnect.count())
 	//	.arg(m_ratsnestUpdateDisconnect.count())
 	//	);
 
-	// TODO: think about ways to optimize this...
+	// nets are gathered and snapshotted here on the gui thread (collectEqualPotential walks the scene),
+	// then the nets of this one view are scored and spanned in parallel while the gui thread waits;
+	// only the VirtualWire changes are made back on the gui thread.
+	// Each view runs its own update from its own signal, so views are not computed concurrently,
+	// and callers read the routing status as soon as this returns, so the wait is not given back to the event loop
 
 	QList< QPointer<VirtualWire> > ratsToDelete;
 
-	QList< QList<ConnectorItem *> > ratnestsToUpdate;
+	QList<NetJob> netJobs;
+	ViewGeometry::WireFlags ratsnestSkipFlags = ConnectorItem::ratsnestSkipFlags(this->getTraceFlag());
 	QList<ConnectorItem *> visited;
 	foreach (QGraphicsItem * item, scene()->items()) {
 		ConnectorItem * connectorItem = dynamic_cast<ConnectorItem *>(item);
@@ -6361,23 +6490,48 @@ void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manua
 
 		if (partConnectorItems.count() < 1) continue;
 
+		NetJob netJob;
+		netJob.partConnectorItems = partConnectorItems;
+		netJob.doRatsnest = doRatsnest;
+		netJob.doScore = partConnectorItems.count() > 1;
 		if (doRatsnest) {
-			ratnestsToUpdate.append(partConnectorItems);
+			GraphUtils::snapshotRatsnest(partConnectorItems, ratsnestSkipFlags, netJob.ratsnestSnapshot);
 		}
-
-		if (partConnectorItems.count() <= 1) continue;
-
-		GraphUtils::scoreOneNet(partConnectorItems, this->getTraceFlag(), routingStatus);
+		if (netJob.doScore) {
+			GraphUtils::snapshotScore(partConnectorItems, this->getTraceFlag(), netJob.scoreSnapshot);
+		}
+		netJobs.append(netJob);
 	}
 
-	routingStatus.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+	if (netJobs.count() > 1) {
+		// blocks the gui thread; the jobs are short, and nothing may touch the scene until they are applied
+		QtConcurrent::blockingMap(netJobs, computeNetJob);
+	}
+	else if (netJobs.count() == 1) {
+		computeNetJob(netJobs[0]);
+	}
 
 	// can't do this in the above loop since VirtualWires and ConnectorItems are added and deleted
-	foreach (QList<ConnectorItem *> partConnectorItems, ratnestsToUpdate) {
-		//partConnectorItems.at(0)->debugInfo("display ratsnest");
-		partConnectorItems.at(0)->displayRatsnest(partConnectorItems, this->getTraceFlag());
+	for (int i = 0; i < netJobs.count(); i++) {
+		NetJob & netJob = netJobs[i];
+		routingStatus.m_netCount += netJob.routingStatus.m_netCount;
+		routingStatus.m_netRoutedCount += netJob.routingStatus.m_netRoutedCount;
+		routingStatus.m_connectorsLeftToRoute += netJob.routingStatus.m_connectorsLeftToRoute;
+		routingStatus.m_jumperItemCount += netJob.routingStatus.m_jumperItemCount;
+
+		if (!netJob.doRatsnest) continue;
+
+		ConnectorPairHash ratsnestGraph;
+		for (int p = 0; p < netJob.ratsnestPairs.count(); p++) {
+			const QPair<int, int> & pair = netJob.ratsnestPairs.at(p);
+			ratsnestGraph.insert(netJob.ratsnestSnapshot.connectorItems.at(pair.first), netJob.ratsnestSnapshot.connectorItems.at(pair.second));
+		}
+		//netJob.partConnectorItems.at(0)->debugInfo("display ratsnest");
+		netJob.partConnectorItems.at(0)->displayRatsnest(netJob.partConnectorItems, this->getTraceFlag(), &ratsnestGraph);
 	}
 
+	routingStatus.m_jumperItemCount /= 4;			// since we counted each connector twice on two layers (4 connectors per jumper item)
+
 	foreach(QPointer<VirtualWire> vw, ratsToDelete) {
 		if (vw != NULL) {
 			vw->debugInfo("removing rat 2");
@@ -6387,15 +6541,10 @@ void SketchWidget::updateRoutingStatus(RoutingStatus & routingStatus, bool manua
 	}
 
 
+	checkLiveDrc(m_ratsnestUpdateConnect + m_ratsnestUpdateDisconnect);
+
 	m_ratsnestUpdateConnect.clear();
 	m_ratsnestUpdateDisconnect.clear();
-
-        /*
-        // uncomment for live drc
-        CMRouter cmRouter(this);
-        QString message;
-        bool result = cmRouter.drc(message);
-        */
 }
 
 
@@ -6630,6 +6779,7 @@ void SketchWidget::forwardRoutingStatus(const RoutingStatus & routingStatus) {
 
 bool SketchWidget::matchesLayer(ModelPart * modelPart) {
 	QDomDocument * domDocument = modelPart->domDocument();
+	if (domDocument == NULL) return false;
 	if (domDocument->isNull()) return false;
 
 	QDomElement views = domDocument->documentElement().firstChildElement("views");
@@ -6876,10 +7026,25 @@ QString translateSVG(QString & svg, QPointF loc, double dpi, double printerScale
 	return svg;
 }
 
+void SketchWidget::beginRenderCache() {
+	// nests, so a batch export can wrap calls that already bracket themselves
+	m_renderCacheDepth++;
+}
+
+void SketchWidget::endRenderCache() {
+	if (m_renderCacheDepth <= 0) return;
+
+	if (--m_renderCacheDepth == 0) {
+		m_renderSvgCache.clear();
+	}
+}
+
 QString SketchWidget::renderToSVG(double printerScale, bool blackOnly, QSizeF & imageSize, QRectF & offsetRect, double dpi, bool flatten,
 								  bool fillHoles, QList<QGraphicsItem *> & itemsAndLabels, QRectF itemsBoundingRect,
 								  bool & empty)
 {
+	TraceSpan traceSpan("SketchWidget::renderToSVG");
+
 	Q_UNUSED(fillHoles);
 	empty = true;
 
@@ -6898,7 +7063,12 @@ QString SketchWidget::renderToSVG(double printerScale, bool blackOnly, QSizeF &
 
 	QString outputSVG = TextUtils::makeSVGHeader(printerScale, dpi, width, height);
 
-	QHash<QString, QString> svgHash;
+	// between beginRenderCache() and endRenderCache() split part svgs are shared across calls;
+	// retrieveSvg keys only by file and layer, so keep a separate table per dpi and color mode
+	QHash<QString, QString> localSvgHash;
+	QHash<QString, QString> & svgHash = (m_renderCacheDepth > 0) 
+		? m_renderSvgCache[QString("%1/%2").arg(dpi).arg(blackOnly)] 
+		: localSvgHash;
 
 	// put them in z order
 	qSort(itemsAndLabels.begin(), itemsAndLabels.end(), zLessThan);
@@ -7857,8 +8027,44 @@ void SketchWidget::paintEvent ( QPaintEvent * event ) {
     //DebugDialog::debug("sketch widget paint event");
     if (scene()) {
         ((FGraphicsScene *) scene())->setDisplayHandles(true);
+		// the navigator shares this scene and sets its own low detail flag, so only hold it for the duration of this paint
+        ((FGraphicsScene *) scene())->setLowDetail(m_lowDetail);
     }
     QGraphicsView::paintEvent(event);
+    if (scene()) {
+        ((FGraphicsScene *) scene())->setLowDetail(false);
+    }
+}
+
+void SketchWidget::lowDetailChanged(bool lowDetail) {
+	foreach (QGraphicsItem * item, scene()->items()) {
+		ItemBase * itemBase = dynamic_cast<ItemBase *>(item);
+		if (itemBase == NULL) continue;
+
+		setLowDetailCache(itemBase, lowDetail);
+	}
+}
+
+void SketchWidget::setLowDetailSuspended(bool suspended) {
+	// the part caches are sized for the zoomed-out view, so full-size renders (export, print) must go around them
+	if (!m_lowDetail) return;
+
+	lowDetailChanged(!suspended);
+}
+
+void SketchWidget::setLowDetailCache(ItemBase * itemBase, bool lowDetail) {
+	// when zoomed out, parts are drawn from a pixmap rendered once at the low detail threshold and scaled down,
+	// rather than going through the svg renderer on every paint.  Wires are long and thin, so they stay uncached.
+	PaletteItemBase * paletteItemBase = qobject_cast<PaletteItemBase *>(itemBase);
+	if (paletteItemBase == NULL) return;
+
+	if (!lowDetail) {
+		paletteItemBase->setCacheMode(QGraphicsItem::NoCache);
+		return;
+	}
+
+	QSizeF size = paletteItemBase->boundingRect().size() * m_lowDetailZoom / 100;
+	paletteItemBase->setCacheMode(QGraphicsItem::ItemCoordinateCache, QSize(qMax(1, qCeil(size.width())), qMax(1, qCeil(size.height()))));
 }
 
 void SketchWidget::setNoteFocus(QGraphicsItem * item, bool inFocus) {
@@ -7987,10 +8193,13 @@ void SketchWidget::collectAllNets(QHash<ConnectorItem *, int> & indexer, QList<
 		allConnectors.append(connectorItem);
 	}
 
-	// find all the nets and make a list of nodes (i.e. part ConnectorItems) for each net
-	while (allConnectors.count() > 0) {
-		
-		ConnectorItem * connectorItem = allConnectors.takeFirst();
+	// find all the nets and make a list of nodes (i.e. part ConnectorItems) for each net;
+	// one pass over the connectors, skipping any already swept into an earlier net
+	QSet<ConnectorItem *> visited;
+	foreach (ConnectorItem * connectorItem, allConnectors) {
+		if (visited.contains(connectorItem)) continue;
+
+		visited.insert(connectorItem);
 		QList<ConnectorItem *> connectorItems;
 		connectorItems.append(connectorItem);
 		ConnectorItem::collectEqualPotential(connectorItems, bothSides, ViewGeometry::NoFlag);
@@ -7999,12 +8208,10 @@ void SketchWidget::collectAllNets(QHash<ConnectorItem *, int> & indexer, QList<
 		}
 
 		foreach (ConnectorItem * ci, connectorItems) {
-			//if (connectorItems.count(ci) > 1) {
-				//DebugDialog::debug("collect equal potential bug");
-			//}
 			//DebugDialog::debug(QString("from in equal potential %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
-			allConnectors.removeOne(ci);
+			visited.insert(ci);
 		}
+		QSet<ConnectorItem *> equalPotential = connectorItems.toSet();
 
 		if (!includeSingletons && (connectorItems.count() <= 1)) {
 			continue;
@@ -8028,7 +8235,7 @@ void SketchWidget::collectAllNets(QHash<ConnectorItem *, int> & indexer, QList<
 			//if (partConnectorItems->count(ci) > 1) {
 				//DebugDialog::debug("collect Parts bug");
 			//}
-			if (!connectorItems.contains(ci)) {
+			if (!equalPotential.contains(ci)) {
 				// crossed layer: toss it
 				//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
 				//	.arg(ci->connectorSharedName())
@@ -213,6 +213,8 @@ public:
 	QString renderToSVG(double printerScale, bool blackOnly, QSizeF & imageSize, QRectF & offsetRect, double dpi, 
 								  bool flatten, bool fillHoles, 
 								  QList<QGraphicsItem *> & itemsAndLabels, QRectF itemsBoundingRect, bool & empty);
+	void beginRenderCache();
+	void endRenderCache();
 
 	bool spaceBarIsPressed();
 	virtual long setUpSwap(ItemBase *, long newModelIndex, const QString & newModuleID, ViewLayer::ViewLayerSpec, bool doEmit, bool noFinalChangeWiresCommand, QList<Wire *> & wiresToDelete, QUndoCommand * parentCommand);
@@ -243,6 +245,7 @@ public:
 	void loadLogoImage(long itemID, const QString & oldSvg, const QSizeF oldAspectRatio, const QString & oldFilename);
 	void loadLogoImage(long itemID, const QString & newFilename, bool addName);
 	void setNoteFocus(QGraphicsItem *, bool inFocus);
+	void setLowDetailSuspended(bool);
 
 	void alignToGrid(bool);
 	bool alignedToGrid();
@@ -307,6 +310,8 @@ protected:
 	void mouseMoveEvent(QMouseEvent *event);
 	void mouseReleaseEvent(QMouseEvent *event);
     void paintEvent(QPaintEvent *);
+	void lowDetailChanged(bool lowDetail);
+	void setLowDetailCache(ItemBase *, bool lowDetail);
     PaletteItem* addPartItem(ModelPart * modelPart, ViewLayer::ViewLayerSpec, PaletteItem * paletteItem, bool doConnectors, bool & ok, ViewIdentifierClass::ViewIdentifier, bool temporary);
 	void clearHoldingSelectItem();
 	bool startZChange(QList<ItemBase *> & bases);
@@ -342,6 +347,8 @@ protected:
 	ChangeConnectionCommand * extendChangeConnectionCommand(BaseCommand::CrossViewType, ConnectorItem * fromConnectorItem, ConnectorItem * toConnectorItem,
 										ViewLayer::ViewLayerSpec,
 										bool connect, QUndoCommand * parentCommand);
+	bool extendChangeConnectionCommand(BulkConnectionCommand *, ConnectorItem * fromConnectorItem, ConnectorItem * toConnectorItem,
+										ViewLayer::ViewLayerSpec, bool connect);
 
 
 	void keyPressEvent(QKeyEvent *);
@@ -356,6 +363,7 @@ protected:
 	virtual bool collectFemaleConnectees(ItemBase *, QSet<ItemBase *> &);
 	virtual bool checkUnder();
 	virtual void findConnectorsUnder(ItemBase * item);
+	virtual void checkLiveDrc(const QList< QPointer<ConnectorItem> > & rewired);
 
 	bool currentlyInfoviewed(ItemBase *item);
 	void resizeEvent(QResizeEvent *);
@@ -365,6 +373,9 @@ protected:
 	void clearDragWireTempCommand();
 	bool draggingWireEnd();
 	void moveItems(QPoint globalPos, bool checkAutoScroll, bool rubberBandLegEnabled);
+	void moveItemsAux(QPointF scenePos);
+	bool startDragProxy();
+	void endDragProxy();
 	virtual ViewLayer::ViewLayerID multiLayerGetViewLayerID(ModelPart * modelPart, ViewIdentifierClass::ViewIdentifier, ViewLayer::ViewLayerSpec, QDomElement & layers, QString & layerName);
 	virtual BaseCommand::CrossViewType wireSplitCrossView();
 	virtual bool canChainMultiple();
@@ -659,6 +670,10 @@ protected:
 	QPointer<QSvgRenderer> m_movingSVGRenderer;
 	QPointF m_movingSVGOffset;
 	QPointer<QGraphicsSvgItem> m_movingItem;
+	QPointer<QGraphicsSvgItem> m_dragProxy;
+	QPointF m_dragProxyScenePos;
+	bool m_dragProxyPending;
+	int m_dragProxyThreshold;
 	QList< QPointer<ConnectorItem> > m_ratsnestUpdateDisconnect;
 	QList< QPointer<ConnectorItem> > m_ratsnestUpdateConnect;
 	QList <ItemBase *> m_checkUnder;
@@ -672,6 +687,8 @@ protected:
 	bool m_rubberBandLegWasEnabled;
 	RoutingStatus m_routingStatus;
 	bool m_anyInRotation;
+	QHash<QString, QHash<QString, QString> > m_renderSvgCache;
+	int m_renderCacheDepth;
 
 public:
 	static ViewLayer::ViewLayerID defaultConnectorLayer(ViewIdentifierClass::ViewIdentifier viewId);
@@ -43,6 +43,8 @@ ZoomableGraphicsView::WheelMapping ZoomableGraphicsView::m_wheelMapping =
 
 bool FirstTime = true;
 
+static const double LowDetailZoom = 50;				// percent; below this parts paint from cached impostors and tiny details are skipped
+
 ZoomableGraphicsView::ZoomableGraphicsView( QWidget * parent )
 	: QGraphicsView(parent)
 {
@@ -50,9 +52,11 @@ ZoomableGraphicsView::ZoomableGraphicsView( QWidget * parent )
 	m_maxScaleValue = 2000;
 	m_minScaleValue = 1;
 	m_acceptWheelEvents = true;
+	m_lowDetail = false;
+	QSettings settings;
+	m_lowDetailZoom = settings.value("lowDetailZoom", LowDetailZoom).toDouble();
 	if (FirstTime) {
 		FirstTime = false;
-		QSettings settings;
 		m_wheelMapping = (WheelMapping) settings.value("wheelMapping", m_wheelMapping).toInt();
 		if (m_wheelMapping >= WheelMappingCount) {
 			m_wheelMapping = ScrollPrimary;
@@ -163,6 +167,12 @@ void ZoomableGraphicsView::relativeZoom(double step, bool centerOnCursor) {
 	}
 	this->setMatrix(matrix);
 
+	bool lowDetail = m_scaleValue < m_lowDetailZoom;
+	if (lowDetail != m_lowDetail) {
+		m_lowDetail = lowDetail;
+		lowDetailChanged(lowDetail);
+	}
+
 	emit zoomChanged(m_scaleValue);
 }
 
@@ -174,6 +184,14 @@ double ZoomableGraphicsView::currentZoom() {
 	return m_scaleValue;
 }
 
+bool ZoomableGraphicsView::lowDetail() {
+	return m_lowDetail;
+}
+
+void ZoomableGraphicsView::lowDetailChanged(bool lowDetail) {
+	Q_UNUSED(lowDetail);
+}
+
 void ZoomableGraphicsView::setAcceptWheelEvents(bool accept) {
 	m_acceptWheelEvents = accept;
 }
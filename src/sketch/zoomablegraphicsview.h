@@ -45,6 +45,7 @@ public:
  	double currentZoom();
 	void setAcceptWheelEvents(bool);
 	virtual void ensureFixedToBottomRightItems() {}
+	bool lowDetail();
 
 
 	
@@ -65,12 +66,15 @@ signals:
 
 protected:
 	virtual void wheelEvent(QWheelEvent* event);
+	virtual void lowDetailChanged(bool lowDetail);
 
 protected:
 	double m_scaleValue;
 	int m_maxScaleValue;
 	int m_minScaleValue;
 	bool m_acceptWheelEvents;
+	double m_lowDetailZoom;
+	bool m_lowDetail;
 
 protected:
 	static WheelMapping m_wheelMapping;
@@ -0,0 +1,402 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#include "contourtracer.h"
+#include "../utils/graphicsutils.h"
+
+#include <QBitArray>
+#include <QVector>
+#include <QPair>
+#include <limits>
+
+// directions in y-down image coordinates; turning right is +1
+static const int East = 0;
+static const int South = 1;
+static const int West = 2;
+static const int North = 3;
+
+static const int DX[4] = { 1, 0, -1, 0 };
+static const int DY[4] = { 0, 1, 0, -1 };
+
+struct Bitmap {
+	int width;
+	int height;
+	QVector<uchar> bits;
+
+	inline bool filled(int x, int y) const {
+		if (x < 0 || y < 0 || x >= width || y >= height) return false;
+
+		return bits.at((y * width) + x) != 0;
+	}
+};
+
+struct Contour {
+	QPolygon polygon;
+	QPointF inside;				// center of a pixel just inside the contour, for matching holes to outlines
+	double area;
+	QRect bounds;
+	QList<int> holes;
+};
+
+static QPolygon followContour(const Bitmap & bitmap, int x, int y, int dir, QBitArray & visited)
+{
+	// walk the pixel edges keeping the white region on the right; only corners are kept.
+	// outlines come out clockwise (positive area), holes counterclockwise.
+	// at a saddle (two white pixels touching diagonally) always turn right, so diagonal neighbors stay separate regions
+
+	QPolygon contour;
+	int startX = x;
+	int startY = y;
+	int startDir = dir;
+	do {
+		if (dir == East) visited.setBit((y * bitmap.width) + x);
+		else if (dir == West) visited.setBit((y * bitmap.width) + x - 1);
+
+		x += DX[dir];
+		y += DY[dir];
+
+		bool left, right;
+		switch (dir) {
+			case East:
+				left = bitmap.filled(x, y - 1);
+				right = bitmap.filled(x, y);
+				break;
+			case South:
+				left = bitmap.filled(x, y);
+				right = bitmap.filled(x - 1, y);
+				break;
+			case West:
+				left = bitmap.filled(x - 1, y);
+				right = bitmap.filled(x - 1, y - 1);
+				break;
+			default:
+				left = bitmap.filled(x - 1, y - 1);
+				right = bitmap.filled(x, y - 1);
+				break;
+		}
+
+		int newDir = dir;
+		if (!right) newDir = (dir + 1) % 4;
+		else if (left) newDir = (dir + 3) % 4;
+
+		if (newDir != dir) {
+			contour.append(QPoint(x, y));
+			dir = newDir;
+		}
+	} while (x != startX || y != startY || dir != startDir);
+
+	return contour;
+}
+
+static inline qint64 cross(const QPoint & o, const QPoint & a, const QPoint & b)
+{
+	return ((qint64) (a.x() - o.x()) * (b.y() - o.y())) - ((qint64) (a.y() - o.y()) * (b.x() - o.x()));
+}
+
+static inline bool withinBox(const QPoint & a, const QPoint & b, const QPoint & p)
+{
+	return p.x() >= qMin(a.x(), b.x()) && p.x() <= qMax(a.x(), b.x()) && p.y() >= qMin(a.y(), b.y()) && p.y() <= qMax(a.y(), b.y());
+}
+
+static bool segmentsTouch(const QPoint & a, const QPoint & b, const QPoint & c, const QPoint & d)
+{
+	// true if the closed segments ab and cd share any point
+	if (qMax(a.x(), b.x()) < qMin(c.x(), d.x()) || qMax(c.x(), d.x()) < qMin(a.x(), b.x())) return false;
+	if (qMax(a.y(), b.y()) < qMin(c.y(), d.y()) || qMax(c.y(), d.y()) < qMin(a.y(), b.y())) return false;
+
+	qint64 d1 = cross(a, b, c);
+	qint64 d2 = cross(a, b, d);
+	qint64 d3 = cross(c, d, a);
+	qint64 d4 = cross(c, d, b);
+	if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) return true;
+
+	// collinear or touching at an endpoint; the bounding boxes already overlap
+	if (d1 == 0 && withinBox(a, b, c)) return true;
+	if (d2 == 0 && withinBox(a, b, d)) return true;
+	if (d3 == 0 && withinBox(c, d, a)) return true;
+	if (d4 == 0 && withinBox(c, d, b)) return true;
+
+	return false;
+}
+
+static bool ringBlocks(const QPolygon & ring, const QPoint & m, const QPoint & p)
+{
+	// does any edge of the ring, other than those ending at m or p, touch the bridge mp?
+	int count = ring.count();
+	for (int i = 0; i < count; i++) {
+		const QPoint & c = ring.at(i);
+		const QPoint & d = ring.at((i + 1) % count);
+		if (c == m || c == p || d == m || d == p) continue;
+		if (segmentsTouch(m, p, c, d)) return true;
+	}
+
+	return false;
+}
+
+static bool ringsTouch(const QPolygon & r1, const QPolygon & r2)
+{
+	if (!r1.boundingRect().intersects(r2.boundingRect())) return false;
+
+	for (int i = 0; i < r1.count(); i++) {
+		const QPoint & a = r1.at(i);
+		const QPoint & b = r1.at((i + 1) % r1.count());
+		for (int j = 0; j < r2.count(); j++) {
+			if (segmentsTouch(a, b, r2.at(j), r2.at((j + 1) % r2.count()))) return true;
+		}
+	}
+
+	return false;
+}
+
+static bool ringsApart(const QPolygon & outline, const QList<QPolygon> & holes)
+{
+	// traced rings never share a point, so after simplifying neither may they
+	for (int h = 0; h < holes.count(); h++) {
+		if (ringsTouch(outline, holes.at(h))) return false;
+		for (int g = h + 1; g < holes.count(); g++) {
+			if (ringsTouch(holes.at(h), holes.at(g))) return false;
+		}
+	}
+
+	return true;
+}
+
+static int rightmost(const QPolygon & ring)
+{
+	int index = 0;
+	for (int i = 1; i < ring.count(); i++) {
+		if (ring.at(i).x() > ring.at(index).x()) index = i;
+	}
+	return index;
+}
+
+static bool rightmostGreaterThan(const QPolygon & h1, const QPolygon & h2)
+{
+	return h1.at(rightmost(h1)).x() > h2.at(rightmost(h2)).x();
+}
+
+static void bridgeHole(QPolygon & outline, const QPolygon & hole, const QList<QPolygon> & otherHoles)
+{
+	// splice the hole in through a zero-width slit from its rightmost vertex to a mutually visible outline vertex:
+	// the nearest one whose bridge crosses no edge of the outline, this hole, or the holes still to be bridged.
+	// the slit is traversed once in each direction so it never changes which points are inside
+
+	int m = rightmost(hole);
+	QPoint h = hole.at(m);
+
+	QList< QPair<qint64, int> > candidates;
+	for (int i = 0; i < outline.count(); i++) {
+		qint64 dx = outline.at(i).x() - h.x();
+		qint64 dy = outline.at(i).y() - h.y();
+		candidates.append(QPair<qint64, int>((dx * dx) + (dy * dy), i));
+	}
+	qSort(candidates);
+
+	int nearest = -1;
+	for (int c = 0; c < candidates.count() && nearest < 0; c++) {
+		QPoint p = outline.at(candidates.at(c).second);
+		if (ringBlocks(outline, h, p)) continue;
+		if (ringBlocks(hole, h, p)) continue;
+
+		bool blocked = false;
+		foreach (QPolygon other, otherHoles) {
+			if (ringBlocks(other, h, p)) {
+				blocked = true;
+				break;
+			}
+		}
+		if (!blocked) nearest = candidates.at(c).second;
+	}
+
+	// can't happen for a hole strictly inside its outline; fall back to the nearest vertex
+	if (nearest < 0) nearest = candidates.at(0).second;
+
+	QPolygon spliced;
+	spliced.reserve(outline.count() + hole.count() + 2);
+	for (int i = 0; i <= nearest; i++) spliced.append(outline.at(i));
+	for (int i = 0; i < hole.count(); i++) spliced.append(hole.at((m + i) % hole.count()));
+	spliced.append(h);
+	for (int i = nearest; i < outline.count(); i++) spliced.append(outline.at(i));
+	outline = spliced;
+}
+
+void ContourTracer::traceImage(QImage & image, int width, int height, double tolerance, QList<QPolygon> & polygons)
+{
+	Bitmap bitmap;
+	bitmap.width = width;
+	bitmap.height = height;
+	bitmap.bits.resize(width * height);
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			bitmap.bits[(y * width) + x] = (image.pixel(x, y) == 0xffffffff) ? 1 : 0;
+		}
+	}
+
+	// every closed contour has at least one horizontal edge, so scanning horizontal edges finds them all
+	QList<Contour> outlines;
+	QList<Contour> holes;
+	QBitArray visited(width * (height + 1));
+	for (int y = 0; y <= height; y++) {
+		for (int x = 0; x < width; x++) {
+			bool above = bitmap.filled(x, y - 1);
+			bool below = bitmap.filled(x, y);
+			if (above == below) continue;
+			if (visited.testBit((y * width) + x)) continue;
+
+			Contour contour;
+			if (below) {
+				contour.polygon = followContour(bitmap, x, y, East, visited);
+				contour.inside = QPointF(x + 0.5, y + 0.5);
+			}
+			else {
+				contour.polygon = followContour(bitmap, x + 1, y, West, visited);
+				contour.inside = QPointF(x + 0.5, y - 0.5);
+			}
+			contour.area = signedArea(contour.polygon);
+			contour.bounds = contour.polygon.boundingRect();
+			if (contour.area > 0) outlines.append(contour);
+			else holes.append(contour);
+		}
+	}
+
+	// a hole belongs to the smallest outline around the white pixel next to it
+	for (int h = 0; h < holes.count(); h++) {
+		QPointF inside = holes.at(h).inside;
+		int owner = -1;
+		for (int o = 0; o < outlines.count(); o++) {
+			const Contour & outline = outlines.at(o);
+			if (!QRectF(outline.bounds).contains(inside)) continue;
+			if (owner >= 0 && outline.area >= outlines.at(owner).area) continue;
+			if (!QPolygonF(outline.polygon).containsPoint(inside, Qt::OddEvenFill)) continue;
+
+			owner = o;
+		}
+		if (owner >= 0) outlines[owner].holes.append(h);
+	}
+
+	foreach (Contour outline, outlines) {
+		QPolygon polygon = simplify(outline.polygon, tolerance);
+		if (polygon.count() < 3) continue;
+
+		QList<QPolygon> outlineHoles;
+		foreach (int h, outline.holes) {
+			QPolygon hole = simplify(holes.at(h).polygon, tolerance);
+			if (hole.count() < 3) continue;
+
+			outlineHoles.append(hole);
+		}
+
+		if (tolerance > 0 && !ringsApart(polygon, outlineHoles)) {
+			// rings are simplified independently, so a hole can end up across its outline or another hole:
+			// keep this region's exact staircase instead
+			polygon = outline.polygon;
+			outlineHoles.clear();
+			foreach (int h, outline.holes) {
+				outlineHoles.append(holes.at(h).polygon);
+			}
+		}
+
+		// rightmost hole first, so a hole is bridged only once every hole to its right is part of the outline
+		qSort(outlineHoles.begin(), outlineHoles.end(), rightmostGreaterThan);
+		while (outlineHoles.count() > 0) {
+			QPolygon hole = outlineHoles.takeFirst();
+			bridgeHole(polygon, hole, outlineHoles);
+		}
+
+		polygons.append(polygon);
+	}
+}
+
+QPolygon ContourTracer::simplify(const QPolygon & ring, double tolerance)
+{
+	if (tolerance <= 0 || ring.count() <= 4) return ring;
+
+	// Douglas-Peucker on a closed ring: split it at the first vertex and the vertex farthest from it
+
+	int count = ring.count();
+	int farthest = 0;
+	qint64 best = -1;
+	for (int i = 1; i < count; i++) {
+		qint64 dx = ring.at(i).x() - ring.at(0).x();
+		qint64 dy = ring.at(i).y() - ring.at(0).y();
+		qint64 d = (dx * dx) + (dy * dy);
+		if (d > best) {
+			best = d;
+			farthest = i;
+		}
+	}
+
+	double tolerance2 = tolerance * tolerance;
+	QVector<bool> keep(count + 1, false);
+	keep[0] = keep[farthest] = keep[count] = true;
+
+	QList< QPair<int, int> > stack;
+	stack.append(QPair<int, int>(0, farthest));
+	stack.append(QPair<int, int>(farthest, count));
+	while (stack.count() > 0) {
+		QPair<int, int> span = stack.takeLast();
+		if (span.second - span.first < 2) continue;
+
+		QPoint a = ring.at(span.first);
+		QPoint b = ring.at(span.second % count);
+		int worst = -1;
+		double worstDistance = tolerance2;
+		for (int i = span.first + 1; i < span.second; i++) {
+			double dx, dy, distance;
+			bool atEndpoint;
+			GraphicsUtils::distanceFromLine(ring.at(i).x(), ring.at(i).y(), a.x(), a.y(), b.x(), b.y(), dx, dy, distance, atEndpoint);
+			if (distance > worstDistance) {
+				worstDistance = distance;
+				worst = i;
+			}
+		}
+		if (worst < 0) continue;
+
+		keep[worst] = true;
+		stack.append(QPair<int, int>(span.first, worst));
+		stack.append(QPair<int, int>(worst, span.second));
+	}
+
+	QPolygon simplified;
+	for (int i = 0; i < count; i++) {
+		if (keep.at(i)) simplified.append(ring.at(i));
+	}
+
+	return simplified;
+}
+
+double ContourTracer::signedArea(const QPolygon & poly)
+{
+	double total = 0;
+	int count = poly.count();
+	for (int ix = 0; ix < count; ix++) {
+		QPoint p0 = poly.at(ix);
+		QPoint p1 = poly.at((ix + 1) % count);
+		total += ((double) p0.x() * p1.y()) - ((double) p1.x() * p0.y());
+	}
+	return total / 2.0;
+}
@@ -0,0 +1,49 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef CONTOURTRACER_H
+#define CONTOURTRACER_H
+
+#include <QImage>
+#include <QList>
+#include <QPolygon>
+
+// Turns the white pixels of a bitmap into closed outlines:
+// pixel edges are followed around each 4-connected region (marching squares on the pixel corners), 
+// the staircase is optionally thinned with Douglas-Peucker (a region whose simplified rings would touch
+// keeps its exact rings), and each hole is bridged into its enclosing outline,
+// so every region comes back as a single polygon that fills correctly with either fill rule.
+
+class ContourTracer
+{
+public:
+	static void traceImage(QImage & image, int width, int height, double tolerance, QList<QPolygon> & polygons);
+	static QPolygon simplify(const QPolygon & ring, double tolerance);
+	static double signedArea(const QPolygon &);
+};
+
+#endif
@@ -38,6 +38,7 @@ $Date: 2012-03-28 04:26:38 -0700 (Wed, 28 Mar 2012) $
 #include "../utils/graphicsutils.h"
 #include "../utils/textutils.h"
 #include "../utils/folderutils.h"
+#include "../utils/tracespan.h"
 
 static QRegExp AaCc("[aAcCqQtTsS]");
 
@@ -77,6 +78,8 @@ bool pixelsCollide(QImage * image1, QImage * image2, int x1, int y1, int x2, int
 
 void GerberGenerator::exportToGerber(const QString & filename, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes) 
 {
+	TraceSpan traceSpan("GerberGenerator::exportToGerber");
+
 	if (board == NULL) {
 		QList<ItemBase *> boards = sketchWidget->findBoard();
 		if (boards.count() == 0) {
@@ -26,6 +26,7 @@ $Date: 2012-03-04 19:23:26 -0800 (Sun, 04 Mar 2012) $
 
 #include "groundplanegenerator.h"
 #include "svgfilesplitter.h"
+#include "contourtracer.h"
 #include "../fsvgrenderer.h"
 #include "../debugdialog.h"
 #include "../version/version.h"
@@ -33,16 +34,19 @@ $Date: 2012-03-04 19:23:26 -0800 (Sun, 04 Mar 2012) $
 #include "../utils/graphicsutils.h"
 #include "../utils/textutils.h"
 #include "../items/wire.h"
+#include "../utils/tracespan.h"
 
 #include <QBitArray>
 #include <QPainter>
 #include <QSvgRenderer>
 #include <QDate>
 #include <QTextStream>
+#include <QSettings>
 #include <qmath.h>
 #include <limits>
 
 static const double BORDERINCHES = 0.04;
+static const double DefaultContourTolerance = 0.5;			// in image pixels
 
 inline int OFFSET(int x, int y, QImage * image) { return (y * image->width()) + x; }
 
@@ -59,6 +63,8 @@ GroundPlaneGenerator::GroundPlaneGenerator()
 	m_blurBy = 0;
 	m_strokeWidthIncrement = 0;
 	m_minRiseSize = m_minRunSize = 1;
+	m_traceContours = false;
+	m_contourTolerance = 0;			// exact pixel outlines unless a caller asks for simplification
 }
 
 GroundPlaneGenerator::~GroundPlaneGenerator() {
@@ -247,6 +253,8 @@ bool GroundPlaneGenerator::generateGroundPlane(const QString & boardSvg, QSizeF
 QImage * GroundPlaneGenerator::generateGroundPlaneAux(const QString & boardSvg, QSizeF boardImageSize, const QString & svg, QSizeF copperImageSize, 
 													QStringList & exceptions, QGraphicsItem * board, double res, double & bWidth, double & bHeight) 
 {
+	TraceSpan traceSpan("GroundPlaneGenerator::render");
+
 	QByteArray boardByteArray;
     QString tempColor("#ffffff");
     if (!SvgFileSplitter::changeColors(boardSvg, tempColor, exceptions, boardByteArray)) {
@@ -365,6 +373,13 @@ void GroundPlaneGenerator::scanImage(QImage & image, double bWidth, double bHeig
 									 const QString & colorString, bool makeConnector, 
 									 bool makeOffset, QSizeF minAreaInches, double minDimensionInches, QPointF polygonOffset)  
 {
+	TraceSpan traceSpan("GroundPlaneGenerator::scanImage");
+
+	if (m_traceContours) {
+		traceImage(image, bWidth, bHeight, pixelFactor, res, colorString, makeConnector, makeOffset, minAreaInches, minDimensionInches, polygonOffset);
+		return;
+	}
+
 	QList<QRect> rects;
 	scanLines(image, bWidth, bHeight, rects);
 	QList< QList<int> * > pieces;
@@ -424,50 +439,119 @@ void GroundPlaneGenerator::scanImage(QImage & image, double bWidth, double bHeig
 
 }
 
-void GroundPlaneGenerator::scanLines(QImage & image, int bWidth, int bHeight, QList<QRect> & rects)
+void GroundPlaneGenerator::traceImage(QImage & image, double bWidth, double bHeight, double pixelFactor, double res, 
+									 const QString & colorString, bool makeConnector, 
+									 bool makeOffset, QSizeF minAreaInches, double minDimensionInches, QPointF polygonOffset)  
 {
-	if (m_minRiseSize > 1) {
-		for (int x = 0; x < bWidth; x++) {
-			bool inWhite = false;
-			int whiteStart = 0;
-			for (int y = 0; y < bHeight; y++) {
-				QRgb current = image.pixel(x, y);
-				if (inWhite) {
-					if (current == 0xffffffff) {			// qBlue(current) == 0xff    gray > 128
-						// another white pixel, keep moving
-						continue;
-					}
+	// same pieces as scanImage, but each one is a single outline instead of a stack of scan line polygons
 
-					// got black: close up this segment;
-					inWhite = false;
-					if (y - whiteStart < m_minRiseSize) {
-						for (int j = whiteStart; j <= y; j++) {
-							image.setPixel(x, j, 0);
-						}
-						continue;
-					}
+	removeShortRises(image, bWidth, bHeight);
+	removeShortRuns(image, bWidth, bHeight);
 
-				}
-				else {
-					if (current != 0xffffffff) {		// qBlue(current) != 0xff				
-						// another black pixel, keep moving
-						continue;
-					}
+	QList<QPolygon> traced;
+	ContourTracer::traceImage(image, bWidth, bHeight, m_contourTolerance, traced);
+
+	QList< QList<QPolygon> > pieces;
+	for (int i = 0; i < traced.count(); i++) {
+		// contour points are pixel corners, so unlike scan line rects there is no off-by-one to correct for
+		QPolygon poly = traced.at(i);
+		for (int j = 0; j < poly.count(); j++) {
+			poly[j] = QPoint(qRound(poly.at(j).x() * pixelFactor), qRound(poly.at(j).y() * pixelFactor));
+		}
 
-					inWhite = true;
-					whiteStart = y;
+		// without offsets every piece lands in the same coordinates, so they may as well share one svg
+		if (makeOffset || pieces.count() == 0) {
+			pieces.append(QList<QPolygon>());
+		}
+		pieces.last().append(poly);
+	}
+
+	foreach (QList<QPolygon> polygons, pieces) {
+		QPointF offset;
+		QString pSvg = makePolySvg(polygons, res, bWidth, bHeight, pixelFactor, colorString, makeConnector, makeOffset ? &offset : NULL, minAreaInches, minDimensionInches, polygonOffset);
+		if (pSvg.isEmpty()) continue;
+
+		m_newSVGs.append(pSvg);
+		if (makeOffset) {
+			offset *= FSvgRenderer::printerScale();
+			m_newOffsets.append(offset);			// offset now in pixels
+		}
+	}
+}
+
+void GroundPlaneGenerator::removeShortRuns(QImage & image, int bWidth, int bHeight)
+{
+	// scanLines drops short runs as it goes; the tracer needs them gone from the image itself
+	if (m_minRunSize <= 1) return;
+
+	for (int y = 0; y < bHeight; y++) {
+		int whiteStart = -1;
+		for (int x = 0; x <= bWidth; x++) {
+			bool white = (x < bWidth) && (image.pixel(x, y) == 0xffffffff);
+			if (white) {
+				if (whiteStart < 0) whiteStart = x;
+				continue;
+			}
+
+			if (whiteStart >= 0 && x - whiteStart < m_minRunSize) {
+				for (int i = whiteStart; i < x; i++) {
+					image.setPixel(i, y, 0);
 				}
 			}
+			whiteStart = -1;
+		}
+	}
+}
+
+void GroundPlaneGenerator::removeShortRises(QImage & image, int bWidth, int bHeight)
+{
+	if (m_minRiseSize <= 1) return;
+
+	for (int x = 0; x < bWidth; x++) {
+		bool inWhite = false;
+		int whiteStart = 0;
+		for (int y = 0; y < bHeight; y++) {
+			QRgb current = image.pixel(x, y);
 			if (inWhite) {
-				// close up the last segment
-				if (bHeight - whiteStart < m_minRiseSize) {
-					for (int j = whiteStart; j <= bHeight; j++) {
+				if (current == 0xffffffff) {			// qBlue(current) == 0xff    gray > 128
+					// another white pixel, keep moving
+					continue;
+				}
+
+				// got black: close up this segment;
+				inWhite = false;
+				if (y - whiteStart < m_minRiseSize) {
+					for (int j = whiteStart; j <= y; j++) {
 						image.setPixel(x, j, 0);
-					}			
+					}
+					continue;
+				}
+
+			}
+			else {
+				if (current != 0xffffffff) {		// qBlue(current) != 0xff				
+					// another black pixel, keep moving
+					continue;
 				}
+
+				inWhite = true;
+				whiteStart = y;
+			}
+		}
+		if (inWhite) {
+			// close up the last segment
+			if (bHeight - whiteStart < m_minRiseSize) {
+				for (int j = whiteStart; j <= bHeight; j++) {
+					image.setPixel(x, j, 0);
+				}			
 			}
 		}
 	}
+}
+
+void GroundPlaneGenerator::scanLines(QImage & image, int bWidth, int bHeight, QList<QRect> & rects)
+{
+	removeShortRises(image, bWidth, bHeight);
 
 	// threshold should be between 0 and 255 exclusive; smaller will include more of the svg
 	for (int y = 0; y < bHeight; y++) {
@@ -1160,3 +1244,16 @@ void GroundPlaneGenerator::setMinRunSize(int mrus, int mris) {
 	m_minRunSize = mrus;
 	m_minRiseSize = mris;
 }
+
+void GroundPlaneGenerator::setTraceContours(bool trace) {
+	m_traceContours = trace;
+}
+
+void GroundPlaneGenerator::setContourTolerance(double tolerance) {
+	m_contourTolerance = tolerance;
+}
+
+double GroundPlaneGenerator::contourToleranceSetting() {
+	QSettings settings;
+	return settings.value("contourTolerance", DefaultContourTolerance).toDouble();
+}
@@ -60,9 +60,12 @@ public:
 	void setLayerName(const QString &);
 	const QString & layerName();
 	void setMinRunSize(int minRunSize, int minRiseSize);
+	void setTraceContours(bool);
+	void setContourTolerance(double);
 
 public:
 	static QString ConnectorName;
+	static double contourToleranceSetting();
 
 signals:
 	void postImageSignal(GroundPlaneGenerator *, QImage *, QGraphicsItem * board);
@@ -79,6 +82,11 @@ protected:
 	void makeConnector(QList<QPolygon> & polygons, double res, double pixelFactor, const QString & colorString, int minX, int minY, QString & svg);
 	bool tryNextPoint(int x, int y, QImage & image, QList<QPoint> & points);
 	void collectBorderPoints(QImage & image, QList<QPoint> & points);
+	void traceImage(QImage & image, double bWidth, double bHeight, double pixelFactor, double res, 
+					const QString & colorString, bool makeConnector, 
+					bool makeOffset, QSizeF minAreaInches, double minDimensionInches, QPointF offsetPolygons);  
+	void removeShortRises(QImage & image, int bWidth, int bHeight);
+	void removeShortRuns(QImage & image, int bWidth, int bHeight);
 
 
 protected:
@@ -89,6 +97,8 @@ protected:
 	double m_strokeWidthIncrement;
 	int m_minRunSize;
 	int m_minRiseSize;
+	bool m_traceContours;
+	double m_contourTolerance;
 };
 
 #endif
@@ -29,6 +29,7 @@ $Date: 2012-03-19 12:11:41 -0700 (Mon, 19 Mar 2012) $
 #include "../utils/misc.h"
 #include "../utils/textutils.h"
 #include "../debugdialog.h"
+#include "../fsvgrenderer.h"
 #include "svgpathparser.h"
 #include "svgpathlexer.h"
 #include "svgpathrunner.h"
@@ -65,13 +66,18 @@ bool SvgFileSplitter::split(const QString & filename, const QString & elementID)
 {
 	m_byteArray.clear();
 
-	QFile file(filename);
-	if (!file.open(QFile::ReadOnly | QFile::Text)) {
-		return false;
+	QByteArray bytes = FSvgRenderer::prefetched(filename);
+	if (bytes.isEmpty()) {
+		QFile file(filename);
+		if (!file.open(QFile::ReadOnly | QFile::Text)) {
+			return false;
+		}
+
+		bytes = file.readAll();
+		file.close();
 	}
 
-	QString contents = file.readAll();
-	file.close();
+	QString contents = bytes;
 
 	return splitString(contents, elementID);
 }
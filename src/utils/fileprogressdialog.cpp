@@ -152,12 +152,12 @@ void FileProgressDialog::setBinLoadingChunk(int chunk)
 	m_binLoadingChunk = chunk;
 }
 
-void FileProgressDialog::loadingInstancesSlot(class ModelBase *, QDomElement & instances)
+void FileProgressDialog::loadingInstancesSlot(class ModelBase *, int instanceCount)
 {
 	m_binLoadingValue = m_binLoadingStart + (++m_binLoadingIndex * m_binLoadingChunk / (double) m_binLoadingCount);
 	setValue(m_binLoadingValue);
 
-	int count = instances.childNodes().count();
+	int count = qMax(1, instanceCount);
 
 	// * 3 comes from: once for model part load, once for list view, once for icon view
 	m_binLoadingInc = m_binLoadingChunk / (double) (m_binLoadingCount * 3 * count);
@@ -57,7 +57,7 @@ public slots:
 	void setMessage(const QString & message);
 	void sendCancel();
 
-	void loadingInstancesSlot(class ModelBase *, QDomElement & instances);
+	void loadingInstancesSlot(class ModelBase *, int instanceCount);
 	void loadingInstanceSlot(class ModelBase *, QDomElement & instance);
 	void settingItemSlot();
 
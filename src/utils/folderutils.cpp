@@ -32,6 +32,7 @@ $Date: 2012-03-28 03:13:01 -0700 (Wed, 28 Mar 2012) $
 #include <QTextStream>
 #include <QUuid>
 #include <QCryptographicHash>
+#include <QtConcurrentMap>
 
 #include "../debugdialog.h"
 #include "../lib/quazip/quazip.h"
@@ -39,6 +40,8 @@ $Date: 2012-03-28 03:13:01 -0700 (Wed, 28 Mar 2012) $
 #include "../lib/qtsysteminfo/QtSystemInfo.h"
 
 
+static const int ZipBufferSize = 32 * 1024;
+
 FolderUtils* FolderUtils::singleton = NULL;
 QString FolderUtils::m_openSaveFolder = "";
 
@@ -326,9 +329,83 @@ void FolderUtils::rmdir(QDir & dir) {
 	dir.rmdir(dir.path());
 }
 
+struct ZipEntry {
+	QString name;
+	QString path;
+	QByteArray compressed;
+	quint32 crc;
+	ulong uncompressedSize;
+	bool ok;
+};
+
+static void deflateEntry(ZipEntry & zipEntry) {
+	// runs on a pool thread: reads and compresses one file; entries are still written to the archive in order
+	zipEntry.ok = false;
+	zipEntry.uncompressedSize = 0;
+
+	QFile inFile(zipEntry.path);
+	if (!inFile.open(QIODevice::ReadOnly)) {
+		qWarning("inFile.open(): %s", inFile.errorString().toLocal8Bit().constData());
+		return;
+	}
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+		qWarning("deflateInit2() failed for %s", zipEntry.name.toLocal8Bit().constData());
+		return;
+	}
+
+	uLong crc = crc32(0L, Z_NULL, 0);
+	char inBuffer[ZipBufferSize];
+	char outBuffer[ZipBufferSize];
+	int flush = Z_NO_FLUSH;
+	while (flush != Z_FINISH) {
+		qint64 count = inFile.read(inBuffer, ZipBufferSize);
+		if (count < 0) {
+			qWarning("inFile.read(): %s", inFile.errorString().toLocal8Bit().constData());
+			deflateEnd(&stream);
+			return;
+		}
+
+		crc = crc32(crc, (const Bytef *) inBuffer, (uInt) count);
+		zipEntry.uncompressedSize += (ulong) count;
+		flush = inFile.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+		stream.next_in = (Bytef *) inBuffer;
+		stream.avail_in = (uInt) count;
+		do {
+			stream.next_out = (Bytef *) outBuffer;
+			stream.avail_out = ZipBufferSize;
+			deflate(&stream, flush);
+			zipEntry.compressed.append(outBuffer, ZipBufferSize - stream.avail_out);
+		} while (stream.avail_out == 0);
+	}
+
+	deflateEnd(&stream);
+	zipEntry.crc = (quint32) crc;
+	zipEntry.ok = true;
+}
+
 bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &filepath) {
 	DebugDialog::debug("zipping "+dirToCompress.path()+" into "+filepath);
 
+	QList<ZipEntry> zipEntries;
+	foreach(QFileInfo file, dirToCompress.entryInfoList()) {
+		if(!file.isFile()||file.fileName()==filepath) continue;
+		if (file.fileName().contains(LockManager::LockedFileName)) continue;
+
+//#pragma message("remove fzz check")
+//if (file.fileName().endsWith(".fzz")) continue;
+
+		ZipEntry zipEntry;
+		zipEntry.name = file.fileName();
+		zipEntry.path = file.absoluteFilePath();
+		zipEntries.append(zipEntry);
+	}
+
+	// compression is independent per entry, so do it on the thread pool
+	QtConcurrent::blockingMap(zipEntries, deflateEntry);
+
 	QString tempZipFile = QDir::temp().path()+"/"+getRandText()+".zip";
 	DebugDialog::debug("temp file: "+tempZipFile);
 	QuaZip zip(tempZipFile);
@@ -337,35 +414,20 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 		return false;
 	}
 
-	QFileInfoList files=dirToCompress.entryInfoList();
-	QFile inFile;
 	QuaZipFile outFile(&zip);
-	char c;
-
-	QString currFolderBU = QDir::currentPath();
-	QDir::setCurrent(dirToCompress.path());
-	foreach(QFileInfo file, files) {
-		if(!file.isFile()||file.fileName()==filepath) continue;
-		if (file.fileName().contains(LockManager::LockedFileName)) continue;
+	foreach (ZipEntry zipEntry, zipEntries) {
+		if (!zipEntry.ok) return false;
 
-//#pragma message("remove fzz check")
-//if (file.fileName().endsWith(".fzz")) continue;
-
-		inFile.setFileName(file.fileName());
-
-		if(!inFile.open(QIODevice::ReadOnly)) {
-			qWarning("inFile.open(): %s", inFile.errorString().toLocal8Bit().constData());
-			return false;
-		}
-		if(!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(inFile.fileName(), inFile.fileName()))) {
+		QuaZipNewInfo newInfo(zipEntry.name, zipEntry.path);
+		newInfo.uncompressedSize = zipEntry.uncompressedSize;
+		if(!outFile.open(QIODevice::WriteOnly, newInfo, NULL, zipEntry.crc, Z_DEFLATED, Z_DEFAULT_COMPRESSION, true)) {
 			qWarning("outFile.open(): %d", outFile.getZipError());
 			return false;
 		}
 
-		while(inFile.getChar(&c)&&outFile.putChar(c)){}
-
+		outFile.write(zipEntry.compressed);
 		if(outFile.getZipError()!=UNZ_OK) {
-			qWarning("outFile.putChar(): %d", outFile.getZipError());
+			qWarning("outFile.write(): %d", outFile.getZipError());
 			return false;
 		}
 		outFile.close();
@@ -373,10 +435,8 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 			qWarning("outFile.close(): %d", outFile.getZipError());
 			return false;
 		}
-		inFile.close();
 	}
 	zip.close();
-	QDir::setCurrent(currFolderBU);
 
 	if(QFileInfo(filepath).exists()) {
 		// if we're here the usr has already accepted to overwrite
@@ -393,8 +453,13 @@ bool FolderUtils::createZipAndSaveTo(const QDir &dirToCompress, const QString &f
 	return true;
 }
 
-
 bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompress) {
+	QHash<QString, QByteArray> inMemory;
+	return unzipTo(filepath, dirToDecompress, ___emptyString___, inMemory);
+}
+
+bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompress, const QString & inMemorySuffix, QHash<QString, QByteArray> & inMemory) {
+	// entries whose names end with inMemorySuffix are also kept in inMemory, so the caller need not read them back from dirToDecompress
 	QuaZip zip(filepath);
 	if(!zip.open(QuaZip::mdUnzip)) {
 		qWarning("zip.open(): %d", zip.getZipError());
@@ -406,7 +471,7 @@ bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompres
 	QuaZipFile file(&zip);
 	QFile out;
 	QString name;
-	char c;
+	char buffer[ZipBufferSize];
 	for(bool more=zip.goToFirstFile(); more; more=zip.goToNextFile()) {
 		if(!zip.getCurrentFileInfo(&info)) {
 			qWarning("getCurrentFileInfo(): %d\n", zip.getZipError());
@@ -430,26 +495,22 @@ bool FolderUtils::unzipTo(const QString &filepath, const QString &dirToDecompres
 			return false;
 		}
 
-		// Slow like hell (on GNU/Linux at least), but it is not my fault.
-		// Not ZIP/UNZIP package's fault either.
-		// The slowest thing here is out.putChar(c).
-		// TODO: now that out.putChar has been replaced with a buffered write, is it still slow under Linux?
-
-#define BUFFERSIZE 1024
-		char buffer[BUFFERSIZE];
-		int ix = 0;
-		while(file.getChar(&c)) {
-			buffer[ix++] = c;
-			if (ix == BUFFERSIZE) {
-				out.write(buffer, ix);
-				ix = 0;
-			}
+		if (!inMemorySuffix.isEmpty() && name.endsWith(inMemorySuffix, Qt::CaseInsensitive)) {
+			QByteArray data = file.readAll();
+			out.write(data);
+			inMemory.insert(name, data);
 		}
-		if (ix > 0) {
-			out.write(buffer, ix);
+		else {
+			while (true) {
+				qint64 count = file.read(buffer, ZipBufferSize);
+				if (count <= 0) break;
+
+				out.write(buffer, count);
+			}
 		}
 
 		out.close();
+
 		if(file.getZipError()!=UNZ_OK) {
 			qWarning("file.getFileName(): %d", file.getZipError());
 			return false;
@@ -31,6 +31,8 @@ $Date: 2012-02-01 01:30:37 -0800 (Wed, 01 Feb 2012) $
 #include <QDir>
 #include <QStringList>
 #include <QFileDialog>
+#include <QHash>
+#include <QByteArray>
 
 #include "misc.h"
 
@@ -56,6 +58,7 @@ public:
 	static void rmdir(QDir & dir);
 	static bool createZipAndSaveTo(const QDir &dirToCompress, const QString &filename);
 	static bool unzipTo(const QString &filepath, const QString &dirToDecompress);
+	static bool unzipTo(const QString &filepath, const QString &dirToDecompress, const QString & inMemorySuffix, QHash<QString, QByteArray> & inMemory);
 	static void replicateDir(QDir srcDir, QDir targDir);
 	static QString getRandText();
 	static void cleanup();
@@ -322,13 +322,22 @@ void GraphUtils::minCut(QList<ConnectorItem *> & connectorItems, QList<SketchWid
 
 
 bool GraphUtils::chooseRatsnestGraph(const QList<ConnectorItem *> * partConnectorItems, ViewGeometry::WireFlags flags, ConnectorPairHash & result) {
-	using namespace boost;
-	typedef adjacency_list < vecS, vecS, undirectedS, property<vertex_distance_t, double>, property < edge_weight_t, double > > Graph;
-	typedef std::pair < int, int >E;
+	RatsnestSnapshot snapshot;
+	if (!snapshotRatsnest(*partConnectorItems, flags, snapshot)) return false;
+
+	QList< QPair<int, int> > pairs;
+	chooseRatsnestPairs(snapshot, pairs);
+	for (int i = 0; i < pairs.count(); i++) {
+		result.insert(snapshot.connectorItems.at(pairs.at(i).first), snapshot.connectorItems.at(pairs.at(i).second));
+	}
 
-	if (partConnectorItems->count() < 2) return false;
+	return true;
+}
+
+bool GraphUtils::snapshotRatsnest(const QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags flags, RatsnestSnapshot & snapshot) {
+	if (partConnectorItems.count() < 2) return false;
 
-	QList <ConnectorItem *> temp(*partConnectorItems);
+	QList <ConnectorItem *> temp(partConnectorItems);
 
 	//DebugDialog::debug("__________________");
 	int tix = 0;
@@ -344,70 +353,71 @@ bool GraphUtils::chooseRatsnestGraph(const QList<ConnectorItem *> * partConnecto
 		}
 	}
 
-	QList<QPointF> locs;
-	foreach (ConnectorItem * connectorItem, temp) {
-		locs << connectorItem->sceneAdjustedTerminalPoint(NULL);
+	int num_nodes = temp.count();
+	snapshot.connectorItems = temp;
+	snapshot.locs.resize(num_nodes);
+	snapshot.wiredTo.fill(-1, num_nodes);
+	snapshot.attachedTo.resize(num_nodes);
+	snapshot.bus.resize(num_nodes);
+
+	// equal potential is symmetric, so one traversal per group is enough to know which pairs are already wired
+	int group = 0;
+	for (int i = 0; i < num_nodes; i++) {
+		ConnectorItem * connectorItem = temp.at(i);
+		snapshot.locs[i] = connectorItem->sceneAdjustedTerminalPoint(NULL);
+		snapshot.attachedTo[i] = connectorItem->attachedTo();
+		snapshot.bus[i] = connectorItem->bus();
+		if (snapshot.wiredTo.at(i) >= 0) continue;
+
+		QList<ConnectorItem *> cwConnectorItems;
+		cwConnectorItems.append(connectorItem);
+		ConnectorItem::collectEqualPotential(cwConnectorItems, true, flags);
+		for (int j = i; j < num_nodes; j++) {
+			if (snapshot.wiredTo.at(j) < 0 && cwConnectorItems.contains(temp.at(j))) {
+				snapshot.wiredTo[j] = group;
+			}
+		}
+		group++;
 	}
 
-	QList < QList<ConnectorItem *> > wiredTo;
+	return true;
+}
+
+void GraphUtils::chooseRatsnestPairs(const RatsnestSnapshot & snapshot, QList< QPair<int, int> > & pairs) {
+	// only reads the snapshot, so it is safe to call from a worker thread
+	using namespace boost;
+	typedef adjacency_list < vecS, vecS, undirectedS, property<vertex_distance_t, double>, property < edge_weight_t, double > > Graph;
+	typedef std::pair < int, int >E;
+
+	int num_nodes = snapshot.connectorItems.count();
+	if (num_nodes < 2) return;
 
-	int num_nodes = temp.count();
 	int num_edges = num_nodes * (num_nodes - 1) / 2;
 	E * edges = new E[num_edges];
 	double * weights = new double[num_edges];
 	int ix = 0;
 	QVector< QVector<double> > reverseWeights(num_nodes, QVector<double>(num_nodes, 0));
 	for (int i = 0; i < num_nodes; i++) {
-		ConnectorItem * c1 = temp.at(i);
-		//c1->debugInfo("c1");
 		for (int j = i + 1; j < num_nodes; j++) {
 			edges[ix].first = i;
 			edges[ix].second = j;
-			ConnectorItem * c2 = temp.at(j);
-			if ((c1->attachedTo() == c2->attachedTo()) && (c1->bus() != NULL) && (c1->bus() == c2->bus())) {
+			if ((snapshot.attachedTo.at(i) == snapshot.attachedTo.at(j)) && (snapshot.bus.at(i) != NULL) && (snapshot.bus.at(i) == snapshot.bus.at(j))) {
 				weights[ix++] = 0;
 				continue;
 			}
 
-			bool already = false;
-			bool checkWiredTo = true;
-			foreach (QList<ConnectorItem *> list, wiredTo) {
-				if (list.contains(c1)) {
-					checkWiredTo = false;
-					if (list.contains(c2)) {
-						weights[ix++] = 0;
-						already = true;
-					}
-					break;
-				}
-			}
-			if (already) continue;
-
-			//c2->debugInfo("\tc2");
-
-			if (checkWiredTo) {
-				QList<ConnectorItem *> cwConnectorItems;
-				cwConnectorItems.append(c1);
-				ConnectorItem::collectEqualPotential(cwConnectorItems, true, flags);
-				wiredTo.append(cwConnectorItems);
-				//foreach (ConnectorItem * cx, cwConnectorItems) {
-					//cx->debugInfo("\t\tcx");
-				//}
-				if (cwConnectorItems.contains(c2)) {
-					weights[ix++] = 0;
-					continue;
-				}
+			if (snapshot.wiredTo.at(i) == snapshot.wiredTo.at(j)) {
+				weights[ix++] = 0;
+				continue;
 			}
 
-			//DebugDialog::debug("c2 not eliminated");
-			double dx = locs[i].x() - locs[j].x();
-			double dy = locs[i].y() - locs[j].y();
+			double dx = snapshot.locs.at(i).x() - snapshot.locs.at(j).x();
+			double dy = snapshot.locs.at(i).y() - snapshot.locs.at(j).y();
 			weights[ix++] = reverseWeights[i][j] = reverseWeights[j][i] = (dx * dx) + (dy * dy);
 		}
 	}
 
 	Graph g(edges, edges + num_edges, weights, num_nodes);
-	property_map<Graph, edge_weight_t>::type weightmap = get(edge_weight, g);
 
 	std::vector < graph_traits < Graph >::vertex_descriptor > p(num_vertices(g));
 
@@ -417,75 +427,55 @@ bool GraphUtils::chooseRatsnestGraph(const QList<ConnectorItem *> * partConnecto
 		if (i == p[i]) continue;
 		if (reverseWeights[i][p[i]] == 0) continue;
 
-		result.insert(temp[i], temp[p[i]]);
+		pairs.append(QPair<int, int>(i, p[i]));
 	}
 
-	delete edges;
-	delete weights;
-
-	return true;
+	delete [] edges;
+	delete [] weights;
 }
 
-#define add_edge_d(i, j, g) \
-	add_edge(verts[i], verts[j], g); \
-	//partConnectorItems[i]->debugInfo(QString("edge from %1").arg(i)); \
-	//partConnectorItems[j]->debugInfo(QString("\tto %1").arg(j));
-
 bool GraphUtils::scoreOneNet(QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags myTrace, RoutingStatus & routingStatus) {
-	using namespace boost;
+	ScoreSnapshot snapshot;
+	snapshotScore(partConnectorItems, myTrace, snapshot);
+	return scoreSnapshot(snapshot, routingStatus);
+}
 
+void GraphUtils::snapshotScore(const QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags myTrace, ScoreSnapshot & snapshot) {
 	int num_nodes = partConnectorItems.count();
+	snapshot.nodeCount = num_nodes;
+	snapshot.jumperConnectorCount = 0;
+	snapshot.gotUserConnection = false;
 
-	typedef property < vertex_index_t, std::size_t > Index;
-	typedef adjacency_list < listS, listS, directedS, Index > graph_t;
-	typedef graph_traits < graph_t >::vertex_descriptor vertex_t;
-	typedef graph_traits < graph_t >::edge_descriptor edge_t;
-
-	graph_t G;
-	std::vector < vertex_t > verts(num_nodes);
-	for (int i = 0; i < num_nodes; ++i) {
-		verts[i] = add_vertex(Index(i), G);
-	}
-
-	//std::pair<int, int> pair;
-	bool gotUserConnection = false;
 	for (int i = 0; i < num_nodes; i++) {
-		add_edge_d(i, i, G);
 		ConnectorItem * from = partConnectorItems[i];
 		for (int j = i + 1; j < num_nodes; j++) {
 			ConnectorItem * to = partConnectorItems[j];
 
 			if (from->isCrossLayerConnectorItem(to)) {
-				add_edge_d(i, j, G);
-				add_edge_d(j, i, G);
+				snapshot.edges.append(QPair<int, int>(i, j));
 				continue;
 			}
 
 			if (to->attachedTo() != from->attachedTo()) {
-				gotUserConnection = true;
+				snapshot.gotUserConnection = true;
 				continue;
 			}
 
 			if ((to->bus() != NULL) && (to->bus() == from->bus())) {	
-				add_edge_d(i, j, G);
-				add_edge_d(j, i, G);
+				snapshot.edges.append(QPair<int, int>(i, j));
 				continue;
 			}
 
-			gotUserConnection = true;
+			snapshot.gotUserConnection = true;
 		}
 	}
 
-	if (!gotUserConnection) {
-		return false;
-	}
-
-	routingStatus.m_netCount++;
+	if (!snapshot.gotUserConnection) return;
 
 	for (int i = 0; i < num_nodes; i++) {
 		ConnectorItem * fromConnectorItem = partConnectorItems[i];
 		if (fromConnectorItem->attachedToItemType() == ModelPart::Jumper) {
-			routingStatus.m_jumperItemCount++;				
+			snapshot.jumperConnectorCount++;				
 		}
 		foreach (ConnectorItem * toConnectorItem, fromConnectorItem->connectedToItems()) {
 			if (toConnectorItem->attachedToItemType() != ModelPart::Wire) {
@@ -508,12 +498,44 @@ bool GraphUtils::scoreOneNet(QList<ConnectorItem *> & partConnectorItems, ViewGe
 
 				int j = partConnectorItems.indexOf(end);
 				if (j >= 0) {
-					add_edge_d(i, j, G);
-					add_edge_d(j, i, G);
+					snapshot.edges.append(QPair<int, int>(i, j));
 				}
 			}
 		}
 	}
+}
+
+#define add_edge_d(i, j, g) \
+	add_edge(verts[i], verts[j], g); \
+	add_edge(verts[j], verts[i], g);
+
+bool GraphUtils::scoreSnapshot(const ScoreSnapshot & snapshot, RoutingStatus & routingStatus) {
+	// only reads the snapshot, so it is safe to call from a worker thread
+	using namespace boost;
+
+	if (!snapshot.gotUserConnection) {
+		return false;
+	}
+
+	int num_nodes = snapshot.nodeCount;
+
+	typedef property < vertex_index_t, std::size_t > Index;
+	typedef adjacency_list < listS, listS, directedS, Index > graph_t;
+	typedef graph_traits < graph_t >::vertex_descriptor vertex_t;
+
+	graph_t G;
+	std::vector < vertex_t > verts(num_nodes);
+	for (int i = 0; i < num_nodes; ++i) {
+		verts[i] = add_vertex(Index(i), G);
+		add_edge(verts[i], verts[i], G);
+	}
+
+	for (int e = 0; e < snapshot.edges.count(); e++) {
+		add_edge_d(snapshot.edges.at(e).first, snapshot.edges.at(e).second, G);
+	}
+
+	routingStatus.m_netCount++;
+	routingStatus.m_jumperItemCount += snapshot.jumperConnectorCount;
 
 	adjacency_list <> TC;
 	transitive_closure(G, TC);
@@ -534,12 +556,6 @@ bool GraphUtils::scoreOneNet(QList<ConnectorItem *> & partConnectorItems, ViewGe
 			else {
 				// we can minimally span the set with n-1 wires, so even if multiple connections are missing from a given connector, count it as one
 				anyMissing = missingOne = true;
-				
-				//ConnectorItem * ci = partConnectorItems.at(i);
-				//ConnectorItem * cj = partConnectorItems.at(j);
-				//ci->debugInfo("missing one ci");
-				//cj->debugInfo("\t\tcj");
-				
 			}
 		}
 		if (missingOne) {
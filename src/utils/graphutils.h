@@ -42,12 +42,34 @@ struct ConnectorEdge {
 	void setHeadTail(int head, int tail);
 };
 
+// Plain copies of one net taken on the gui thread; the graph work on them never touches a QGraphicsItem,
+// so it can be handed to a worker thread.  ConnectorItem and ItemBase pointers are only used as handles.
+
+struct RatsnestSnapshot {
+	QList<ConnectorItem *> connectorItems;
+	QVector<QPointF> locs;
+	QVector<int> wiredTo;					// equal-potential group index
+	QVector<ItemBase *> attachedTo;
+	QVector<const class Bus *> bus;
+};
+
+struct ScoreSnapshot {
+	int nodeCount;
+	int jumperConnectorCount;
+	bool gotUserConnection;
+	QList< QPair<int, int> > edges;
+};
+
 class GraphUtils
 {
 
 public:
 	static bool chooseRatsnestGraph(const QList<ConnectorItem *> * equipotentials, ViewGeometry::WireFlags, ConnectorPairHash & result);
 	static bool scoreOneNet(QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags, RoutingStatus & routingStatus);
+	static bool snapshotRatsnest(const QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags, RatsnestSnapshot &);
+	static void chooseRatsnestPairs(const RatsnestSnapshot &, QList< QPair<int, int> > & pairs);
+	static void snapshotScore(const QList<ConnectorItem *> & partConnectorItems, ViewGeometry::WireFlags, ScoreSnapshot &);
+	static bool scoreSnapshot(const ScoreSnapshot &, RoutingStatus & routingStatus);
 	static void minCut(QList<ConnectorItem *> & connectorItems, QList<class SketchWidget *> & foreighSketchWidgets, ConnectorItem * source, ConnectorItem * sink, QList<ConnectorEdge *> & cutSet); 
 };
 
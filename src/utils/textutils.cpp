@@ -585,6 +585,14 @@ QString TextUtils::escapeAnd(const QString & string) {
 	return s;
 }
 
+QString TextUtils::csvField(const QString & field) {
+	if (!field.contains(',') && !field.contains('"') && !field.contains('\n') && !field.contains('\r')) return field;
+
+	QString quoted = field;
+	quoted.replace("\"", "\"\"");
+	return "\"" + quoted + "\"";
+}
+
 QString TextUtils::convertExtendedChars(const QString & str) 
 {
 	QString result;
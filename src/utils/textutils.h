@@ -73,6 +73,7 @@ public:
 	static QString stripNonValidXMLCharacters(const QString & str); 
 	static QString convertExtendedChars(const QString & str); 
 	static QString escapeAnd(const QString &);
+	static QString csvField(const QString &);
 	static QMatrix elementToMatrix(QDomElement & element);
 	static QMatrix transformStringToMatrix(const QString & transform);
     static QList<double> getTransformFloats(QDomElement & element);
@@ -0,0 +1,115 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#include "tracespan.h"
+#include "../debugdialog.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QHash>
+#include <QList>
+
+struct TraceEvent {
+	const char * name;
+	int start;
+	int end;
+	int thread;
+};
+
+bool TraceSpan::Enabled = false;
+QTime TraceSpan::Timer;
+
+static QString TraceFileName;
+static QList<TraceEvent> TraceEvents;
+static QHash<Qt::HANDLE, int> TraceThreads;
+static QMutex TraceMutex;					// spans can close on QtConcurrent worker threads
+
+void TraceSpan::start(const QString & fileName)
+{
+	TraceFileName = fileName;
+	Timer.start();
+	Enabled = true;
+}
+
+bool TraceSpan::enabled()
+{
+	return Enabled;
+}
+
+void TraceSpan::record(const char * name, int start, int end)
+{
+	QMutexLocker locker(&TraceMutex);
+
+	Qt::HANDLE threadID = QThread::currentThreadId();
+	int thread = TraceThreads.value(threadID, -1);
+	if (thread < 0) {
+		thread = TraceThreads.count();
+		TraceThreads.insert(threadID, thread);
+	}
+
+	TraceEvent traceEvent;
+	traceEvent.name = name;
+	traceEvent.start = start;
+	traceEvent.end = end;
+	traceEvent.thread = thread;
+	TraceEvents.append(traceEvent);
+}
+
+void TraceSpan::finish()
+{
+	if (!Enabled) return;
+
+	Enabled = false;
+
+	QMutexLocker locker(&TraceMutex);
+
+	QFile file(TraceFileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		DebugDialog::debug(QString("unable to write trace file %1").arg(TraceFileName));
+		return;
+	}
+
+	// QTime only resolves milliseconds; trace_event wants microseconds
+	QTextStream out(&file);
+	out << "{\"traceEvents\": [\n";
+	for (int i = 0; i < TraceEvents.count(); i++) {
+		const TraceEvent & traceEvent = TraceEvents.at(i);
+		out << QString("{\"name\": \"%1\", \"cat\": \"fritzing\", \"ph\": \"X\", \"ts\": %2, \"dur\": %3, \"pid\": 1, \"tid\": %4}%5\n")
+			.arg(traceEvent.name)
+			.arg((qint64) traceEvent.start * 1000)
+			.arg((qint64) (traceEvent.end - traceEvent.start) * 1000)
+			.arg(traceEvent.thread)
+			.arg(i < TraceEvents.count() - 1 ? "," : "");
+	}
+	out << "],\n\"displayTimeUnit\": \"ms\"\n}\n";
+	file.close();
+
+	TraceEvents.clear();
+}
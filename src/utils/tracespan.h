@@ -0,0 +1,67 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2012 Fachhochschule Potsdam - http://fh-potsdam.de
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************
+
+$Revision$:
+$Author$:
+$Date$
+
+********************************************************************/
+
+
+#ifndef TRACESPAN_H
+#define TRACESPAN_H
+
+#include <QString>
+#include <QTime>
+
+// Scoped timing for the slow paths.  Declare a TraceSpan at the top of a block and its lifetime is recorded;
+// when tracing is off (the default) construction and destruction are a single flag test.
+// Started from the -trace command line option; finish() writes Chrome trace_event json, which chrome://tracing can load.
+
+class TraceSpan
+{
+public:
+	inline TraceSpan(const char * name) {
+		m_name = Enabled ? name : NULL;
+		if (m_name) m_start = Timer.elapsed();
+	}
+
+	inline ~TraceSpan() {
+		if (m_name) record(m_name, m_start, Timer.elapsed());
+	}
+
+public:
+	static void start(const QString & fileName);
+	static void finish();
+	static bool enabled();
+
+protected:
+	static void record(const char * name, int start, int end);
+
+protected:
+	const char * m_name;
+	int m_start;
+
+protected:
+	static bool Enabled;
+	static QTime Timer;
+};
+
+#endif